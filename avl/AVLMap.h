@@ -0,0 +1,583 @@
+#ifndef AVL_MAP_H
+#define AVL_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "NodePool.h"
+#include "TreeIterator.h"
+
+template <typename K, typename V>
+struct AVLMapNode {
+  std::pair<const K, V> entry;
+  int height;
+  AVLMapNode* left;
+  AVLMapNode* right;
+  AVLMapNode* parent;  // For iteration; the root's is nullptr
+
+  template <typename... Args>
+  explicit AVLMapNode(Args&&... args)
+      : entry(std::forward<Args>(args)...),
+        height(1),
+        left(nullptr),
+        right(nullptr),
+        parent(nullptr) {
+  }
+};
+
+// Ordered map on an AVL tree, for keys other than int. Entries are constructed in place and never
+// copied or moved afterwards: rotations and erase only relink nodes, so values may be move-only
+// (or not movable at all) and iterators stay valid until their own entry is erased.
+//
+// With a transparent comparator such as std::less<> the lookups (find, contains, lowerBound,
+// upperBound, erase) and tryEmplace take any type the comparator accepts, so a std::string-keyed
+// map can be searched with a std::string_view without building a std::string first.
+//
+// Nodes live in the map's NodePool; the destructor and clear() destroy them in one O(n) walk
+// when K or V have destructors to run, and just drop the slabs otherwise.
+template <typename K, typename V, typename Compare = std::less<K>>
+class AVLMap {
+  using Node = AVLMapNode<K, V>;
+
+  template <typename C, typename = void>
+  struct IsTransparent : std::false_type {};
+  template <typename C>
+  struct IsTransparent<C, std::void_t<typename C::is_transparent>> : std::true_type {};
+
+  // Lookups take other key types only through a transparent comparator, like std::map
+  template <typename Key>
+  using IfTransparent = std::enable_if_t<IsTransparent<Compare>::value && !std::is_same_v<Key, K>, int>;
+
+  Node* root = nullptr;
+  size_t count = 0;
+  NodePool<Node> pool;
+  Compare compare;
+
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<const K, V>;
+
+  template <bool IsConst>
+  class Iterator {
+    using NodePtr = std::conditional_t<IsConst, const Node*, Node*>;
+    using RootPtr = Node* const*;
+
+    NodePtr node = nullptr;
+    RootPtr root = nullptr;
+
+    friend class AVLMap;
+    template <bool>
+    friend class Iterator;
+
+    Iterator(NodePtr node, RootPtr root)
+        : node(node), root(root) {
+    }
+
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = AVLMap::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<IsConst, const value_type*, value_type*>;
+    using reference = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+    Iterator() = default;
+
+    // iterator converts to const_iterator
+    template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+    Iterator(const Iterator<OtherConst>& other)
+        : node(other.node), root(other.root) {
+    }
+
+    reference operator*() const {
+      return node->entry;
+    }
+
+    pointer operator->() const {
+      return &node->entry;
+    }
+
+    Iterator& operator++() {
+      node = successor(node);
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator previous = *this;
+      ++*this;
+      return previous;
+    }
+
+    Iterator& operator--() {
+      node = node ? predecessor(node) : rightmost<NodePtr>(*root);
+      return *this;
+    }
+
+    Iterator operator--(int) {
+      Iterator previous = *this;
+      --*this;
+      return previous;
+    }
+
+    bool operator==(const Iterator& other) const {
+      return node == other.node;
+    }
+
+    bool operator!=(const Iterator& other) const {
+      return node != other.node;
+    }
+  };
+
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+ private:
+  static int getHeight(const Node* node) {
+    return node ? node->height : 0;
+  }
+
+  static int getBalanceFactor(const Node* node) {
+    return node ? getHeight(node->left) - getHeight(node->right) : 0;
+  }
+
+  static void updateNode(Node* node) {
+    node->height = std::max(getHeight(node->left), getHeight(node->right)) + 1;
+    if (node->left) {
+      node->left->parent = node;
+    }
+    if (node->right) {
+      node->right->parent = node;
+    }
+  }
+
+  static Node* rotateRight(Node* y) {
+    Node* x = y->left;
+    y->left = x->right;
+    x->right = y;
+    updateNode(y);
+    updateNode(x);
+    return x;
+  }
+
+  static Node* rotateLeft(Node* x) {
+    Node* y = x->right;
+    x->right = y->left;
+    y->left = x;
+    updateNode(x);
+    updateNode(y);
+    return y;
+  }
+
+  static Node* balance(Node* node) {
+    updateNode(node);
+    int balanceFactor = getBalanceFactor(node);
+
+    if (balanceFactor > 1) {
+      // Left Right Case
+      if (getBalanceFactor(node->left) < 0) {
+        node->left = rotateLeft(node->left);
+      }
+      // Left Left Case
+      return rotateRight(node);
+    }
+
+    if (balanceFactor < -1) {
+      // Right Left Case
+      if (getBalanceFactor(node->right) > 0) {
+        node->right = rotateRight(node->right);
+      }
+      // Right Right Case
+      return rotateLeft(node);
+    }
+
+    return node;
+  }
+
+  void setRoot(Node* node) {
+    root = node;
+    if (root) {
+      root->parent = nullptr;
+    }
+  }
+
+  // Hangs the node returned by make() where `key` belongs, unless the key is already present.
+  // `result` is set to the node that holds the key afterwards.
+  template <typename Key, typename Make>
+  Node* insert(Node* node, const Key& key, Make& make, Node*& result) {
+    if (!node) {
+      result = make();
+      return result;
+    }
+    if (compare(key, node->entry.first)) {
+      node->left = insert(node->left, key, make, result);
+    } else if (compare(node->entry.first, key)) {
+      node->right = insert(node->right, key, make, result);
+    } else {
+      result = node;
+      return node;
+    }
+    return balance(node);
+  }
+
+  // Searches with `key` as given and constructs the entry's K from it only if it is missing
+  template <typename Key, typename... Args>
+  std::pair<iterator, bool> tryEmplaceKey(Key&& key, Args&&... args) {
+    bool inserted = false;
+    auto make = [&] {
+      inserted = true;
+      return pool.create(std::piecewise_construct, std::forward_as_tuple(std::forward<Key>(key)),
+                         std::forward_as_tuple(std::forward<Args>(args)...));
+    };
+    Node* result = nullptr;
+    setRoot(insert(root, key, make, result));
+    count += inserted;
+    return {iterator(result, &root), inserted};
+  }
+
+  // Puts `fresh` where `old` hangs under `parent` (or at the root)
+  void replaceChild(Node* parent, Node* old, Node* fresh) {
+    if (!parent) {
+      root = fresh;
+    } else if (parent->left == old) {
+      parent->left = fresh;
+    } else {
+      parent->right = fresh;
+    }
+    if (fresh) {
+      fresh->parent = parent;
+    }
+  }
+
+  // Makes one comparison per level: the descent keeps going right past an equal key, so it ends on
+  // the in-order successor of the match, or on the match itself when that has no right subtree.
+  // Rebalancing walks up the parent links and stops at the first subtree whose height is unchanged.
+  template <typename Key>
+  bool eraseNode(const Key& key) {
+    Node* match = nullptr;  // Last node whose key is not greater than `key`
+    Node* last = nullptr;
+    for (Node* node = root; node;) {
+      last = node;
+      if (compare(key, node->entry.first)) {
+        node = node->left;
+      } else {
+        match = node;
+        node = node->right;
+      }
+    }
+    if (!match || compare(match->entry.first, key)) {
+      return false;
+    }
+
+    Node* start;  // Lowest node whose subtree lost a level
+    if (last == match) {
+      start = match->parent;
+      replaceChild(start, match, match->left);
+    } else {
+      // The successor node itself takes the erased node's place
+      Node* successor = last;
+      if (successor->parent == match) {
+        start = successor;
+      } else {
+        start = successor->parent;
+        start->left = successor->right;
+        if (successor->right) {
+          successor->right->parent = start;
+        }
+        successor->right = match->right;
+        successor->right->parent = successor;
+      }
+      successor->left = match->left;
+      if (successor->left) {
+        successor->left->parent = successor;
+      }
+      successor->height = match->height;
+      replaceChild(match->parent, match, successor);
+    }
+    pool.destroy(match);
+
+    for (Node* node = start; node;) {
+      Node* parent = node->parent;
+      int oldHeight = node->height;
+      Node* subtree = balance(node);
+      if (subtree != node) {
+        replaceChild(parent, node, subtree);
+      }
+      if (subtree->height == oldHeight) {
+        break;
+      }
+      node = parent;
+    }
+    return true;
+  }
+
+  template <typename Key>
+  Node* findNode(const Key& key) const {
+    Node* node = root;
+    while (node) {
+      if (compare(key, node->entry.first)) {
+        node = node->left;
+      } else if (compare(node->entry.first, key)) {
+        node = node->right;
+      } else {
+        return node;
+      }
+    }
+    return nullptr;
+  }
+
+  // First node whose key is not less than `key` (or greater than it, when `strict` is set)
+  template <typename Key>
+  Node* lowerBoundNode(const Key& key, bool strict) const {
+    Node* result = nullptr;
+    Node* node = root;
+    while (node) {
+      bool goLeft = strict ? compare(key, node->entry.first) : !compare(node->entry.first, key);
+      if (goLeft) {
+        result = node;
+        node = node->left;
+      } else {
+        node = node->right;
+      }
+    }
+    return result;
+  }
+
+  // Post-order walk over the parent links, so it needs no stack
+  void destroyAll() {
+    Node* node = root;
+    while (node) {
+      if (node->left) {
+        node = node->left;
+      } else if (node->right) {
+        node = node->right;
+      } else {
+        Node* parent = node->parent;
+        if (parent) {
+          (parent->left == node ? parent->left : parent->right) = nullptr;
+        }
+        pool.destroy(node);
+        node = parent;
+      }
+    }
+  }
+
+ public:
+  AVLMap() = default;
+
+  explicit AVLMap(const Compare& compare)
+      : compare(compare) {
+  }
+
+  AVLMap(const AVLMap&) = delete;
+  AVLMap& operator=(const AVLMap&) = delete;
+
+  // Nodes stay in the moved pool, so iterators into `other` now point into this map
+  AVLMap(AVLMap&& other) noexcept
+      : root(std::exchange(other.root, nullptr)),
+        count(std::exchange(other.count, 0)),
+        pool(std::move(other.pool)),
+        compare(std::move(other.compare)) {
+  }
+
+  AVLMap& operator=(AVLMap&& other) noexcept {
+    if (this != &other) {
+      clear();
+      root = std::exchange(other.root, nullptr);
+      count = std::exchange(other.count, 0);
+      pool = std::move(other.pool);
+      compare = std::move(other.compare);
+    }
+    return *this;
+  }
+
+  ~AVLMap() {
+    clear();
+  }
+
+  // Constructs the entry from `args` (as std::pair<const K, V> would be), then links it in unless
+  // its key is present already, in which case it is destroyed again. Returns the entry holding the
+  // key and whether it was inserted.
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    Node* fresh = pool.create(std::forward<Args>(args)...);
+    auto make = [fresh] { return fresh; };
+    Node* result = nullptr;
+    setRoot(insert(root, fresh->entry.first, make, result));
+    if (result != fresh) {
+      pool.destroy(fresh);
+      return {iterator(result, &root), false};
+    }
+    count++;
+    return {iterator(result, &root), true};
+  }
+
+  // Like emplace, but the value is only constructed, from `args`, if `key` is missing
+  template <typename... Args>
+  std::pair<iterator, bool> tryEmplace(const K& key, Args&&... args) {
+    return tryEmplaceKey(key, std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> tryEmplace(K&& key, Args&&... args) {
+    return tryEmplaceKey(std::move(key), std::forward<Args>(args)...);
+  }
+
+  // Through a transparent comparator the key may be any comparable type; a K is built from it only
+  // when it is missing
+  template <typename Key, typename... Args, IfTransparent<std::decay_t<Key>> = 0>
+  std::pair<iterator, bool> tryEmplace(Key&& key, Args&&... args) {
+    return tryEmplaceKey(std::forward<Key>(key), std::forward<Args>(args)...);
+  }
+
+  // Inserts a value-initialized entry if `key` is missing
+  V& operator[](const K& key) {
+    return tryEmplace(key).first->second;
+  }
+
+  V& operator[](K&& key) {
+    return tryEmplace(std::move(key)).first->second;
+  }
+
+  V& at(const K& key) {
+    Node* node = findNode(key);
+    if (!node) {
+      throw std::out_of_range("AVLMap::at: key not found");
+    }
+    return node->entry.second;
+  }
+
+  const V& at(const K& key) const {
+    const Node* node = findNode(key);
+    if (!node) {
+      throw std::out_of_range("AVLMap::at: key not found");
+    }
+    return node->entry.second;
+  }
+
+  iterator find(const K& key) {
+    return iterator(findNode(key), &root);
+  }
+
+  const_iterator find(const K& key) const {
+    return const_iterator(findNode(key), &root);
+  }
+
+  template <typename Key, IfTransparent<Key> = 0>
+  iterator find(const Key& key) {
+    return iterator(findNode(key), &root);
+  }
+
+  template <typename Key, IfTransparent<Key> = 0>
+  const_iterator find(const Key& key) const {
+    return const_iterator(findNode(key), &root);
+  }
+
+  bool contains(const K& key) const {
+    return findNode(key) != nullptr;
+  }
+
+  template <typename Key, IfTransparent<Key> = 0>
+  bool contains(const Key& key) const {
+    return findNode(key) != nullptr;
+  }
+
+  // First entry whose key is not less than `key`
+  iterator lowerBound(const K& key) {
+    return iterator(lowerBoundNode(key, false), &root);
+  }
+
+  const_iterator lowerBound(const K& key) const {
+    return const_iterator(lowerBoundNode(key, false), &root);
+  }
+
+  template <typename Key, IfTransparent<Key> = 0>
+  const_iterator lowerBound(const Key& key) const {
+    return const_iterator(lowerBoundNode(key, false), &root);
+  }
+
+  // First entry whose key is greater than `key`
+  iterator upperBound(const K& key) {
+    return iterator(lowerBoundNode(key, true), &root);
+  }
+
+  const_iterator upperBound(const K& key) const {
+    return const_iterator(lowerBoundNode(key, true), &root);
+  }
+
+  template <typename Key, IfTransparent<Key> = 0>
+  const_iterator upperBound(const Key& key) const {
+    return const_iterator(lowerBoundNode(key, true), &root);
+  }
+
+  // Calls visit(key, value) for every entry with low <= key <= high, in key order
+  template <typename Key, typename Visit>
+  void forEachInRange(const Key& low, const Key& high, Visit&& visit) const {
+    for (const Node* node = lowerBoundNode(low, false); node && !compare(high, node->entry.first);
+         node = successor(node)) {
+      visit(node->entry.first, node->entry.second);
+    }
+  }
+
+  // Returns false if `key` was not present
+  bool erase(const K& key) {
+    bool erased = eraseNode(key);
+    count -= erased;
+    return erased;
+  }
+
+  template <typename Key, IfTransparent<Key> = 0>
+  bool erase(const Key& key) {
+    bool erased = eraseNode(key);
+    count -= erased;
+    return erased;
+  }
+
+  iterator begin() {
+    return iterator(leftmost(root), &root);
+  }
+
+  iterator end() {
+    return iterator(nullptr, &root);
+  }
+
+  const_iterator begin() const {
+    return const_iterator(leftmost(root), &root);
+  }
+
+  const_iterator end() const {
+    return const_iterator(nullptr, &root);
+  }
+
+  void clear() {
+    if constexpr (!std::is_trivially_destructible_v<Node>) {
+      destroyAll();
+    }
+    root = nullptr;
+    count = 0;
+    pool.clear();
+  }
+
+  size_t size() const {
+    return count;
+  }
+
+  bool empty() const {
+    return count == 0;
+  }
+
+  int height() const {
+    return getHeight(root);
+  }
+
+  size_t bytesReserved() const {
+    return pool.bytesReserved();
+  }
+};
+
+#endif  // AVL_MAP_H
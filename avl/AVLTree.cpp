@@ -1,182 +1,13 @@
-#include <cmath>
-#include <iomanip>
 #include <iostream>
-#include <memory>
-#include <queue>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
 
-#include "TreePrinter.h"
-
-class AVLTree {
-  std::unique_ptr<Node> root;
-
- private:
-  int getHeight(const std::unique_ptr<Node>& node) const {
-    return node ? node->height : 0;
-  }
-
-  int getBalanceFactor(const std::unique_ptr<Node>& node) const {
-    return node ? getHeight(node->left) - getHeight(node->right) : 0;
-  }
-
-  void updateHeight(std::unique_ptr<Node>& node) {
-    if (node) {
-      node->height = std::max(getHeight(node->left), getHeight(node->right)) + 1;
-    }
-  }
-
-  std::unique_ptr<Node> rotateRight(std::unique_ptr<Node>& y) {
-    std::unique_ptr<Node> x = std::move(y->left);
-    std::unique_ptr<Node> T2 = std::move(x->right);
-
-    x->right = std::move(y);
-    x->right->left = std::move(T2);
-
-    updateHeight(x->right);
-    updateHeight(x);
-
-    return x;
-  }
-
-  std::unique_ptr<Node> rotateLeft(std::unique_ptr<Node>& x) {
-    std::unique_ptr<Node> y = std::move(x->right);
-    std::unique_ptr<Node> T2 = std::move(y->left);
-
-    y->left = std::move(x);
-    y->left->right = std::move(T2);
-
-    updateHeight(y->left);
-    updateHeight(y);
-
-    return y;
-  }
-
-  std::unique_ptr<Node> balance(std::unique_ptr<Node>& node) {
-    if (!node) {
-      return nullptr;
-    }
-
-    updateHeight(node);
-
-    int balanceFactor = getBalanceFactor(node);
-
-    // Left Left Case
-    if (balanceFactor > 1 && getBalanceFactor(node->left) >= 0) {
-      return rotateRight(node);
-    }
-
-    // Right Right Case
-    if (balanceFactor < -1 && getBalanceFactor(node->right) <= 0) {
-      return rotateLeft(node);
-    }
-
-    // Left Right Case
-    if (balanceFactor > 1 && getBalanceFactor(node->left) < 0) {
-      node->left = rotateLeft(node->left);
-      return rotateRight(node);
-    }
-
-    // Right Left Case
-    if (balanceFactor < -1 && getBalanceFactor(node->right) > 0) {
-      node->right = rotateRight(node->right);
-      return rotateLeft(node);
-    }
-
-    return std::move(node);
-  }
-
-  void insert(int value, std::unique_ptr<Node>& node) {
-    if (!node) {
-      node = std::make_unique<Node>(value);
-      return;
-    }
-
-    if (value < node->value) {
-      insert(value, node->left);
-    } else if (value > node->value) {
-      insert(value, node->right);
-    } else {
-      return;
-    }
-
-    node = balance(node);
-  }
-
-  bool contains(int value, const std::unique_ptr<Node>& node) const {
-    if (!node) {
-      return false;
-    }
-    if (node->value == value) {
-      return true;
-    }
-    if (value < node->value) {
-      return contains(value, node->left);
-    }
-    return contains(value, node->right);
-  }
-
-  std::unique_ptr<Node>& findMin(std::unique_ptr<Node>& node) {
-    if (!node->left) {
-      return node;
-    }
-    return findMin(node->left);
-  }
-
-  void deleteNode(int value, std::unique_ptr<Node>& node) {
-    if (!node) {
-      return;
-    }
-
-    if (value < node->value) {
-      deleteNode(value, node->left);
-    } else if (value > node->value) {
-      deleteNode(value, node->right);
-    } else {
-      if (!node->left || !node->right) {
-        std::unique_ptr<Node> temp = node->left ? std::move(node->left) : std::move(node->right);
-        if (!temp) {
-          node = nullptr;
-        } else {
-          node = std::move(temp);
-        }
-      } else {
-        auto& minNode = findMin(node->right);
-        node->value = minNode->value;
-        deleteNode(minNode->value, node->right);
-      }
-    }
-
-    if (!node) {
-      return;
-    }
-
-    node = balance(node);
-  }
-
- public:
-  void insert(int value) {
-    insert(value, root);
-  }
-
-  bool contains(int value) const {
-    return contains(value, root);
-  }
-
-  void deleteNode(int value) {
-    deleteNode(value, root);
-  }
-
-  void printTree() {
-    if (!root) {
-      std::cout << "Puste drzewo\n";
-      return;
-    }
-    std::vector<std::vector<std::string>> result = treeToMatrix(root);
-
-    print2DArray(result);
-  }
-};
+#include "AVLMap.h"
+#include "AVLTree.h"
+#include "ConcurrentAVLTree.h"
+#include "PersistentAVLTree.h"
 
 int main() {
   AVLTree tree;
@@ -199,8 +30,77 @@ int main() {
   std::cout << "Zawiera 10: " << (tree.contains(10) ? "Tak" : "Nie") << std::endl;
   std::cout << "Zawiera 25: " << (tree.contains(25) ? "Tak" : "Nie") << std::endl;
 
+  std::cout << "Pozycja 15: " << tree.rank(15) << std::endl;
+  std::cout << "Element nr 3: " << tree.select(3) << std::endl;
+  std::cout << "Liczba elementow w [3, 31]: " << tree.countInRange(3, 31) << std::endl;
+
   tree.deleteNode(10);
   tree.printTree();
 
+  std::vector<int> squares = {1, 4, 9, 16, 25};
+  AVLTree merged = AVLTree::setUnion(std::move(tree), AVLTree::fromSorted(squares.begin(), squares.end()));
+  std::cout << "Suma z kwadratami:\n";
+  merged.printTree();
+
+  StaticIndex frozen = merged.freeze();
+  std::cout << "Najmniejszy element >= 17: " << frozen.lowerBound(17).value_or(-1) << std::endl;
+
+  std::cout << "Elementy w [10, 40]:";
+  merged.forEachInRange(10, 40, [](int value) { std::cout << ' ' << value; });
+  std::cout << "\nPierwszy element > 25: " << *merged.upperBound(25) << std::endl;
+  std::cout << "Od konca:";
+  for (auto it = merged.end(); it != merged.begin();) {
+    std::cout << ' ' << *--it;
+  }
+  std::cout << std::endl;
+
+  // Four threads fill disjoint ranges of one shared tree while a fifth keeps reading it
+  ConcurrentAVLTree shared;
+  std::vector<std::thread> writers;
+  for (int t = 0; t < 4; t++) {
+    writers.emplace_back([&shared, t] {
+      for (int value = t * 1000; value < (t + 1) * 1000; value++) {
+        shared.insert(value);
+      }
+    });
+  }
+  std::thread reader([&shared] {
+    for (int value = 0; value < 4000; value++) {
+      shared.contains(value);
+    }
+  });
+  for (auto& writer : writers) {
+    writer.join();
+  }
+  reader.join();
+  std::cout << "Wspolbiezne drzewo: " << shared.size() << " elementow, wysokosc " << shared.height() << std::endl;
+
+  // A snapshot keeps its version while the tree moves on; both share the untouched subtrees
+  PersistentAVLTree versions;
+  for (int value = 1; value <= 7; value++) {
+    versions.insert(value);
+  }
+  PersistentAVLTree::Snapshot before = versions.snapshot();
+  versions.deleteNode(4);
+  versions.insert(8);
+  std::cout << "Migawka:";
+  before.forEachInRange(1, 10, [](int value) { std::cout << ' ' << value; });
+  std::cout << "\nPo zmianach:";
+  versions.forEachInRange(1, 10, [](int value) { std::cout << ' ' << value; });
+  std::cout << "\nWezly obu wersji: " << versions.nodesAllocated() << std::endl;
+
+  // std::less<> lets the map be searched with a string_view, without building a std::string
+  AVLMap<std::string, int, std::less<>> population;
+  population.emplace("Krakow", 800);
+  population.emplace("Gdansk", 486);
+  population.tryEmplace("Warszawa", 1860);
+  population["Poznan"] = 540;
+  std::string_view city = "Gdansk";
+  std::cout << "Mieszkancy " << city << " (tys.): " << population.find(city)->second << std::endl;
+  std::cout << "Miasta od G do Q:";
+  population.forEachInRange(std::string_view("G"), std::string_view("Q"),
+                            [](const std::string& name, int) { std::cout << ' ' << name; });
+  std::cout << std::endl;
+
   return 0;
 }
@@ -0,0 +1,667 @@
+#ifndef AVL_TREE_H
+#define AVL_TREE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "NodePool.h"
+#include "StaticIndex.h"
+#include "TreeIterator.h"
+#include "TreePrinter.h"
+
+struct AVLNode {
+  int value;
+  int height;
+  int size;  // Nodes in this subtree, for rank/select
+  AVLNode* left;
+  AVLNode* right;
+  AVLNode* parent;  // For iteration; the root's is nullptr
+
+  AVLNode(int v)
+      : value(v),
+        height(1),
+        size(1),
+        left(nullptr),
+        right(nullptr),
+        parent(nullptr) {
+  }
+};
+
+// Nodes live in a NodePool, so destroying or clearing the tree releases them slab by slab instead
+// of one node at a time. The pool is normally the tree's own; the two halves of a split() share
+// their parent's pool, so trees that came out of one split must not be modified concurrently.
+class AVLTree {
+  AVLNode* root;
+  std::shared_ptr<NodePool<AVLNode>> pool;  // Created on first use
+
+  // Set operations fork when both inputs together hold at least this many nodes, down to
+  // MAX_PARALLEL_DEPTH levels of recursion (at most 2^depth concurrent tasks).
+  static constexpr int PARALLEL_CUTOFF = 1 << 16;
+  static constexpr int MAX_PARALLEL_DEPTH = 4;
+
+  struct SplitResult {
+    AVLNode* left;   // Keys below the split key
+    AVLNode* match;  // Detached node holding the split key, or nullptr
+    AVLNode* right;  // Keys above the split key
+  };
+
+  AVLTree(AVLNode* root, std::shared_ptr<NodePool<AVLNode>> pool)
+      : root(root),
+        pool(std::move(pool)) {
+    setRoot(root);
+  }
+
+ private:
+  NodePool<AVLNode>& nodes() {
+    if (!pool) {
+      pool = std::make_shared<NodePool<AVLNode>>();
+    }
+    return *pool;
+  }
+
+  void setRoot(AVLNode* node) {
+    root = node;
+    if (root) {
+      root->parent = nullptr;
+    }
+  }
+
+  int getHeight(const AVLNode* node) const {
+    return node ? node->height : 0;
+  }
+
+  int getSize(const AVLNode* node) const {
+    return node ? node->size : 0;
+  }
+
+  int getBalanceFactor(const AVLNode* node) const {
+    return node ? getHeight(node->left) - getHeight(node->right) : 0;
+  }
+
+  // Recomputes height and subtree size from the children and points the children back at the
+  // node. Every rotation, rebalance and join goes through here, which keeps all three correct on
+  // the whole insert/delete path; only the root's parent is reset separately, by setRoot().
+  void updateNode(AVLNode* node) {
+    if (node) {
+      node->height = std::max(getHeight(node->left), getHeight(node->right)) + 1;
+      node->size = getSize(node->left) + getSize(node->right) + 1;
+      if (node->left) {
+        node->left->parent = node;
+      }
+      if (node->right) {
+        node->right->parent = node;
+      }
+    }
+  }
+
+  AVLNode* rotateRight(AVLNode* y) {
+    AVLNode* x = y->left;
+    AVLNode* T2 = x->right;
+
+    x->right = y;
+    y->left = T2;
+
+    updateNode(y);
+    updateNode(x);
+
+    return x;
+  }
+
+  AVLNode* rotateLeft(AVLNode* x) {
+    AVLNode* y = x->right;
+    AVLNode* T2 = y->left;
+
+    y->left = x;
+    x->right = T2;
+
+    updateNode(x);
+    updateNode(y);
+
+    return y;
+  }
+
+  AVLNode* balance(AVLNode* node) {
+    if (!node) {
+      return nullptr;
+    }
+
+    updateNode(node);
+
+    int balanceFactor = getBalanceFactor(node);
+
+    // Left Left Case
+    if (balanceFactor > 1 && getBalanceFactor(node->left) >= 0) {
+      return rotateRight(node);
+    }
+
+    // Right Right Case
+    if (balanceFactor < -1 && getBalanceFactor(node->right) <= 0) {
+      return rotateLeft(node);
+    }
+
+    // Left Right Case
+    if (balanceFactor > 1 && getBalanceFactor(node->left) < 0) {
+      node->left = rotateLeft(node->left);
+      return rotateRight(node);
+    }
+
+    // Right Left Case
+    if (balanceFactor < -1 && getBalanceFactor(node->right) > 0) {
+      node->right = rotateRight(node->right);
+      return rotateLeft(node);
+    }
+
+    return node;
+  }
+
+  void insert(int value, AVLNode*& node) {
+    if (!node) {
+      node = nodes().create(value);
+      return;
+    }
+
+    if (value < node->value) {
+      insert(value, node->left);
+    } else if (value > node->value) {
+      insert(value, node->right);
+    } else {
+      return;
+    }
+
+    node = balance(node);
+  }
+
+  // Number of keys smaller than `value` (or not greater, when `inclusive` is set)
+  size_t countBelow(int value, bool inclusive) const {
+    size_t count = 0;
+    const AVLNode* node = root;
+    while (node) {
+      if (value < node->value || (!inclusive && value == node->value)) {
+        node = node->left;
+      } else {
+        count += getSize(node->left) + 1;
+        node = node->right;
+      }
+    }
+    return count;
+  }
+
+  AVLNode* findMin(AVLNode* node) {
+    if (!node->left) {
+      return node;
+    }
+    return findMin(node->left);
+  }
+
+  void deleteNode(int value, AVLNode*& node) {
+    if (!node) {
+      return;
+    }
+
+    if (value < node->value) {
+      deleteNode(value, node->left);
+    } else if (value > node->value) {
+      deleteNode(value, node->right);
+    } else {
+      if (!node->left || !node->right) {
+        AVLNode* temp = node->left ? node->left : node->right;
+        pool->destroy(node);
+        node = temp;
+      } else {
+        AVLNode* minNode = findMin(node->right);
+        node->value = minNode->value;
+        deleteNode(minNode->value, node->right);
+      }
+    }
+
+    if (!node) {
+      return;
+    }
+
+    node = balance(node);
+  }
+
+  // Join-based bulk operations (Blelloch, Ferizovic, Sun: "Just Join for Parallel Ordered Sets").
+  // They only relink existing nodes: join takes the middle key as a ready node, split hands back
+  // the node that held the split key, and the set operations collect the subtrees they drop in
+  // `discarded`. The pool is not thread-safe, so it is touched only after the parallel part is done.
+
+  // Builds the subtree for the next `count` keys of `next`, consuming them in order
+  template <typename It>
+  AVLNode* build(It& next, size_t count) {
+    if (count == 0) {
+      return nullptr;
+    }
+    size_t middle = count / 2;
+    AVLNode* left = build(next, middle);
+    AVLNode* node = nodes().create(*next);
+    ++next;
+    node->left = left;
+    node->right = build(next, count - middle - 1);
+    updateNode(node);
+    return node;
+  }
+
+  // Walks down the right spine of the taller left tree to a subtree of matching height, hangs
+  // `middle` there and rebalances on the way back up, as an insertion would.
+  AVLNode* joinRight(AVLNode* left, AVLNode* middle, AVLNode* right) {
+    if (getHeight(left) <= getHeight(right) + 1) {
+      middle->left = left;
+      middle->right = right;
+      updateNode(middle);
+      return middle;
+    }
+    left->right = joinRight(left->right, middle, right);
+    return balance(left);
+  }
+
+  AVLNode* joinLeft(AVLNode* left, AVLNode* middle, AVLNode* right) {
+    if (getHeight(right) <= getHeight(left) + 1) {
+      middle->left = left;
+      middle->right = right;
+      updateNode(middle);
+      return middle;
+    }
+    right->left = joinLeft(left, middle, right->left);
+    return balance(right);
+  }
+
+  // Keys in `left` < middle->value < keys in `right`. O(|height(left) - height(right)|).
+  AVLNode* joinNodes(AVLNode* left, AVLNode* middle, AVLNode* right) {
+    if (getHeight(left) > getHeight(right) + 1) {
+      return joinRight(left, middle, right);
+    }
+    return joinLeft(left, middle, right);
+  }
+
+  AVLNode* removeMax(AVLNode* node, AVLNode*& max) {
+    if (!node->right) {
+      max = node;
+      AVLNode* left = node->left;
+      node->left = nullptr;
+      return left;
+    }
+    node->right = removeMax(node->right, max);
+    return balance(node);
+  }
+
+  // Join without a middle key: the largest key of `left` takes that role
+  AVLNode* joinNodes(AVLNode* left, AVLNode* right) {
+    if (!left) {
+      return right;
+    }
+    AVLNode* max = nullptr;
+    left = removeMax(left, max);
+    return joinNodes(left, max, right);
+  }
+
+  SplitResult splitNode(AVLNode* node, int key) {
+    if (!node) {
+      return {nullptr, nullptr, nullptr};
+    }
+    AVLNode* left = node->left;
+    AVLNode* right = node->right;
+    if (key == node->value) {
+      node->left = node->right = nullptr;
+      updateNode(node);
+      return {left, node, right};
+    }
+    if (key < node->value) {
+      SplitResult parts = splitNode(left, key);
+      return {parts.left, parts.match, joinNodes(parts.right, node, right)};
+    }
+    SplitResult parts = splitNode(right, key);
+    return {joinNodes(left, node, parts.left), parts.match, parts.right};
+  }
+
+  // Runs both halves of a set operation, the right one on another thread when the inputs are big
+  // enough. Each side collects its discarded subtrees separately; they are merged afterwards.
+  template <typename LeftTask, typename RightTask>
+  void forkJoin(int depth, size_t work, LeftTask leftTask, RightTask rightTask,
+                std::vector<AVLNode*>& discarded, AVLNode*& left, AVLNode*& right) {
+    if (work < PARALLEL_CUTOFF || depth >= MAX_PARALLEL_DEPTH) {
+      left = leftTask(discarded);
+      right = rightTask(discarded);
+      return;
+    }
+    std::vector<AVLNode*> rightDiscarded;
+    auto pending = std::async(std::launch::async, [&] { return rightTask(rightDiscarded); });
+    left = leftTask(discarded);
+    right = pending.get();
+    discarded.insert(discarded.end(), rightDiscarded.begin(), rightDiscarded.end());
+  }
+
+  AVLNode* unionNodes(AVLNode* a, AVLNode* b, std::vector<AVLNode*>& discarded, int depth) {
+    if (!a) {
+      return b;
+    }
+    if (!b) {
+      return a;
+    }
+    SplitResult parts = splitNode(b, a->value);
+    if (parts.match) {
+      discarded.push_back(parts.match);  // Duplicate of a's root
+    }
+    AVLNode* aLeft = a->left;
+    AVLNode* aRight = a->right;
+    AVLNode *left, *right;
+    forkJoin(
+        depth, getSize(a) + getSize(b),
+        [&](std::vector<AVLNode*>& out) { return unionNodes(aLeft, parts.left, out, depth + 1); },
+        [&](std::vector<AVLNode*>& out) { return unionNodes(aRight, parts.right, out, depth + 1); },
+        discarded, left, right);
+    return joinNodes(left, a, right);
+  }
+
+  AVLNode* intersectNodes(AVLNode* a, AVLNode* b, std::vector<AVLNode*>& discarded, int depth) {
+    if (!a || !b) {
+      if (a) {
+        discarded.push_back(a);
+      }
+      if (b) {
+        discarded.push_back(b);
+      }
+      return nullptr;
+    }
+    SplitResult parts = splitNode(b, a->value);
+    AVLNode* aLeft = a->left;
+    AVLNode* aRight = a->right;
+    AVLNode *left, *right;
+    forkJoin(
+        depth, getSize(a) + getSize(b),
+        [&](std::vector<AVLNode*>& out) { return intersectNodes(aLeft, parts.left, out, depth + 1); },
+        [&](std::vector<AVLNode*>& out) { return intersectNodes(aRight, parts.right, out, depth + 1); },
+        discarded, left, right);
+    if (parts.match) {
+      discarded.push_back(parts.match);
+      return joinNodes(left, a, right);
+    }
+    a->left = a->right = nullptr;
+    discarded.push_back(a);
+    return joinNodes(left, right);
+  }
+
+  AVLNode* subtractNodes(AVLNode* a, AVLNode* b, std::vector<AVLNode*>& discarded, int depth) {
+    if (!a || !b) {
+      if (b) {
+        discarded.push_back(b);
+      }
+      return a;
+    }
+    SplitResult parts = splitNode(a, b->value);
+    AVLNode* bLeft = b->left;
+    AVLNode* bRight = b->right;
+    AVLNode *left, *right;
+    forkJoin(
+        depth, getSize(a) + getSize(b),
+        [&](std::vector<AVLNode*>& out) { return subtractNodes(parts.left, bLeft, out, depth + 1); },
+        [&](std::vector<AVLNode*>& out) { return subtractNodes(parts.right, bRight, out, depth + 1); },
+        discarded, left, right);
+    if (parts.match) {
+      discarded.push_back(parts.match);
+    }
+    b->left = b->right = nullptr;
+    discarded.push_back(b);
+    return joinNodes(left, right);
+  }
+
+  void releaseSubtrees(const std::vector<AVLNode*>& subtrees) {
+    std::vector<AVLNode*> stack(subtrees.begin(), subtrees.end());
+    while (!stack.empty()) {
+      AVLNode* node = stack.back();
+      stack.pop_back();
+      if (node->left) {
+        stack.push_back(node->left);
+      }
+      if (node->right) {
+        stack.push_back(node->right);
+      }
+      pool->destroy(node);
+    }
+  }
+
+  AVLNode* copySubtree(const AVLNode* node) {
+    if (!node) {
+      return nullptr;
+    }
+    AVLNode* copy = nodes().create(*node);
+    copy->left = copySubtree(node->left);
+    copy->right = copySubtree(node->right);
+    updateNode(copy);
+    return copy;
+  }
+
+  // Makes `other`'s nodes owned by this tree's pool so the two trees can be linked together.
+  // Normally that just moves other's slabs over; if other's pool is shared with a split sibling
+  // its nodes are copied instead.
+  void absorb(AVLTree& other) {
+    if (!other.root || other.pool == pool) {
+      return;
+    }
+    if (other.pool.use_count() == 1) {
+      nodes().adopt(std::move(*other.pool));
+    } else {
+      other.root = copySubtree(other.root);
+    }
+    other.pool = pool;
+  }
+
+ public:
+  AVLTree()
+      : root(nullptr) {
+  }
+
+  AVLTree(const AVLTree&) = delete;
+  AVLTree& operator=(const AVLTree&) = delete;
+
+  AVLTree(AVLTree&& other) noexcept
+      : root(std::exchange(other.root, nullptr)),
+        pool(std::move(other.pool)) {
+  }
+
+  // Builds a perfectly balanced tree from strictly increasing keys in O(n), without rotations.
+  // Throws std::invalid_argument if the keys are not strictly increasing.
+  template <typename It>
+  static AVLTree fromSorted(It first, It last) {
+    if (std::adjacent_find(first, last, std::greater_equal<>()) != last) {
+      throw std::invalid_argument("AVLTree::fromSorted: keys must be strictly increasing");
+    }
+    AVLTree tree;
+    size_t count = static_cast<size_t>(std::distance(first, last));
+    tree.setRoot(tree.build(first, count));
+    return tree;
+  }
+
+  // Concatenates `left`, `key` and `right`, which must be ordered: every key of `left` < key <
+  // every key of `right` (std::invalid_argument otherwise). O(log n) plus adopting right's pool,
+  // which is O(number of slabs); if that pool is still shared with a split sibling, right's nodes
+  // are copied instead, in O(size of right).
+  static AVLTree join(AVLTree&& left, int key, AVLTree&& right) {
+    if ((left.root && left.select(left.size() - 1) >= key) || (right.root && right.select(0) <= key)) {
+      throw std::invalid_argument("AVLTree::join: keys of the left tree must be < key < keys of the right tree");
+    }
+    AVLTree result(std::move(left));
+    result.absorb(right);
+    AVLNode* middle = result.nodes().create(key);
+    result.setRoot(result.joinNodes(result.root, middle, std::exchange(right.root, nullptr)));
+    return result;
+  }
+
+  // Splits `tree` into the keys below and above `key`; `key` itself is dropped. O(log n). The two
+  // halves share the original tree's pool.
+  static std::pair<AVLTree, AVLTree> split(AVLTree&& tree, int key) {
+    SplitResult parts = tree.splitNode(std::exchange(tree.root, nullptr), key);
+    if (parts.match) {
+      tree.pool->destroy(parts.match);
+    }
+    return {AVLTree(parts.left, tree.pool), AVLTree(parts.right, tree.pool)};
+  }
+
+  // Set operations on two trees, consuming both. O(m log(n / m + 1)) work for sizes m <= n, with
+  // the recursive halves running in parallel on large inputs.
+  static AVLTree setUnion(AVLTree&& a, AVLTree&& b) {
+    AVLTree result(std::move(a));
+    result.absorb(b);
+    std::vector<AVLNode*> discarded;
+    result.setRoot(result.unionNodes(result.root, std::exchange(b.root, nullptr), discarded, 0));
+    result.releaseSubtrees(discarded);
+    return result;
+  }
+
+  static AVLTree setIntersection(AVLTree&& a, AVLTree&& b) {
+    AVLTree result(std::move(a));
+    result.absorb(b);
+    std::vector<AVLNode*> discarded;
+    result.setRoot(result.intersectNodes(result.root, std::exchange(b.root, nullptr), discarded, 0));
+    result.releaseSubtrees(discarded);
+    return result;
+  }
+
+  // Keys of `a` that are not in `b`
+  static AVLTree setDifference(AVLTree&& a, AVLTree&& b) {
+    AVLTree result(std::move(a));
+    result.absorb(b);
+    std::vector<AVLNode*> discarded;
+    result.setRoot(result.subtractNodes(result.root, std::exchange(b.root, nullptr), discarded, 0));
+    result.releaseSubtrees(discarded);
+    return result;
+  }
+
+  AVLTree& operator=(AVLTree&& other) noexcept {
+    root = std::exchange(other.root, nullptr);
+    pool = std::move(other.pool);
+    return *this;
+  }
+
+  void insert(int value) {
+    insert(value, root);
+    setRoot(root);
+  }
+
+  bool contains(int value) const {
+    const AVLNode* node = root;
+    while (node && node->value != value) {
+      node = value < node->value ? node->left : node->right;
+    }
+    return node != nullptr;
+  }
+
+  // Invalidates iterators to the deleted key and to its successor, whose node takes its place
+  void deleteNode(int value) {
+    deleteNode(value, root);
+    setRoot(root);
+  }
+
+  // Iterators stay valid across insertions. Each step is O(1) amortized over a full scan.
+  using const_iterator = TreeIterator<AVLNode>;
+
+  const_iterator begin() const {
+    return const_iterator(leftmost(root), &root);
+  }
+
+  const_iterator end() const {
+    return const_iterator(nullptr, &root);
+  }
+
+  // First key not less than `value`
+  const_iterator lowerBound(int value) const {
+    return const_iterator(lowerBoundNode(root, value), &root);
+  }
+
+  // First key greater than `value`
+  const_iterator upperBound(int value) const {
+    return const_iterator(lowerBoundNode(root, value, true), &root);
+  }
+
+  // Calls visit(key) for every key in [low, high] in ascending order. O(log n + k), no allocation.
+  template <typename Visit>
+  void forEachInRange(int low, int high, Visit&& visit) const {
+    forEachNodeInRange(root, low, high, visit);
+  }
+
+  // Number of keys strictly smaller than `value`; equals the 0-based position of `value` if present
+  size_t rank(int value) const {
+    return countBelow(value, false);
+  }
+
+  // The k-th smallest key, counting from 0
+  int select(size_t k) const {
+    if (k >= size()) {
+      throw std::out_of_range("AVLTree::select: index " + std::to_string(k) + " out of range");
+    }
+    const AVLNode* node = root;
+    while (true) {
+      size_t leftSize = getSize(node->left);
+      if (k < leftSize) {
+        node = node->left;
+      } else if (k == leftSize) {
+        return node->value;
+      } else {
+        k -= leftSize + 1;
+        node = node->right;
+      }
+    }
+  }
+
+  // Number of keys in the closed range [lo, hi]
+  size_t countInRange(int lo, int hi) const {
+    if (lo > hi) {
+      return 0;
+    }
+    return countBelow(hi, true) - countBelow(lo, false);
+  }
+
+  // Drops every node in O(number of slabs). A pool shared with a split sibling is left to it.
+  void clear() {
+    root = nullptr;
+    if (pool.use_count() == 1) {
+      pool->clear();
+    } else {
+      pool.reset();
+    }
+  }
+
+  size_t size() const {
+    return getSize(root);
+  }
+
+  size_t bytesReserved() const {
+    return pool ? pool->bytesReserved() : 0;
+  }
+
+  int height() const {
+    return getHeight(root);
+  }
+
+  // Keys in ascending order
+  std::vector<int> toSortedVector() const {
+    return collectInorder(root, size());
+  }
+
+  // Read-only snapshot of the current keys in a cache-friendly array layout. Later changes to the
+  // tree do not show up in the snapshot.
+  StaticIndex freeze(StaticIndex::Layout layout = StaticIndex::Layout::Eytzinger) const {
+    return StaticIndex(toSortedVector(), layout);
+  }
+
+  void printTree() {
+    if (!root) {
+      std::cout << "Puste drzewo\n";
+      return;
+    }
+    std::vector<std::vector<std::string>> result = treeToMatrix(root);
+
+    print2DArray(result);
+  }
+};
+
+#endif  // AVL_TREE_H
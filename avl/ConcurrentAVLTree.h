@@ -0,0 +1,535 @@
+#ifndef CONCURRENT_AVL_TREE_H
+#define CONCURRENT_AVL_TREE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "EpochReclamation.h"
+
+// Minimal lock for tree nodes: one byte instead of a 40-byte std::mutex, and critical sections are
+// a handful of pointer writes. Waiters yield so a preempted holder can finish on a busy machine.
+class SpinLock {
+  std::atomic<bool> locked{false};
+
+ public:
+  void lock() {
+    while (locked.exchange(true, std::memory_order_acquire)) {
+      while (locked.load(std::memory_order_relaxed)) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  void unlock() {
+    locked.store(false, std::memory_order_release);
+  }
+};
+
+struct ConcurrentAVLNode {
+  const int value;
+  std::atomic<int> height;
+  std::atomic<uint32_t> version;  // See ConcurrentAVLTree::SHRINKING and UNLINKED
+  std::atomic<bool> present;      // False for routing nodes left behind by deleteNode
+  SpinLock lock;
+  std::atomic<ConcurrentAVLNode*> parent;
+  std::atomic<ConcurrentAVLNode*> child[2];  // LEFT, RIGHT
+
+  ConcurrentAVLNode(int val, ConcurrentAVLNode* parentNode)
+      : value(val), height(1), version(0), present(true), parent(parentNode), child{nullptr, nullptr} {
+  }
+};
+
+// The flags share one word with the key so a node fits a 48-byte heap chunk
+static_assert(sizeof(ConcurrentAVLNode) == 40, "ConcurrentAVLNode grew");
+
+// Ordered set of ints that many threads can use at once, after Bronson, Casper, Chafi and
+// Olukotun, "A Practical Concurrent Binary Search Tree" (PPoPP 2010).
+//
+// Readers take no locks. Every node carries a version number that a rotation marks as SHRINKING
+// while the node's subtree loses keys, and bumps afterwards. A reader descends hand-over-hand:
+// it reads the child pointer, then checks that the parent's version has not changed, so the child
+// really covered the key range it was reached through. On a mismatch it backs up one level and
+// retries from there rather than from the root.
+//
+// Writers search the same way, then lock only the nodes they modify, always parent before child:
+// an insert locks the node it hangs the new leaf on, an unlink locks the parent and the node, and
+// a rotation locks the parent, the node and the child that moves up. Balance is relaxed: heights
+// are repaired and rotations done bottom-up after the change, each step under its own locks, so
+// the tree can briefly be out of AVL balance while other threads keep working in it.
+//
+// deleteNode on a node with two children just marks it as absent (a routing node) instead of
+// moving its successor, which readers could miss mid-flight. Routing nodes are unlinked once
+// they are down to one child. Unlinked nodes are freed through an EpochDomain, so a reader that
+// still stands on one never touches freed memory.
+//
+// Nodes are separate heap allocations: a NodePool is not thread-safe.
+
+class ConcurrentAVLTree {
+  using Node = ConcurrentAVLNode;
+
+  static constexpr int LEFT = 0;
+  static constexpr int RIGHT = 1;
+
+  static constexpr uint32_t UNLINKED = 1;
+  static constexpr uint32_t SHRINKING = 2;
+  static constexpr uint32_t CHANGE_COUNT = 4;  // Bits above the flags count finished rotations
+
+  // nodeCondition() results; anything else is the node's correct height
+  static constexpr int UNLINK_REQUIRED = -1;
+  static constexpr int REBALANCE_REQUIRED = -2;
+  static constexpr int NOTHING_REQUIRED = -3;
+
+  enum class Outcome { Retry, Again, False, True };
+
+  // Holds no key; the tree proper is its right child. Its version never changes, so a search that
+  // starts here never has to restart from scratch.
+  Node holder;
+  std::atomic<size_t> count{0};
+  mutable EpochDomain epochs;
+
+  static int height(const Node* node) {
+    return node ? node->height.load() : 0;
+  }
+
+  static uint32_t beginChange(uint32_t version) {
+    return version | SHRINKING;
+  }
+
+  static uint32_t endChange(uint32_t version) {
+    return (version & ~(UNLINKED | SHRINKING)) + CHANGE_COUNT;
+  }
+
+  static void waitUntilNotShrinking(const Node* node) {
+    while (node->version.load() & SHRINKING) {
+      std::this_thread::yield();
+    }
+  }
+
+  // Hand-over-hand optimistic search below `node`, which was reached with version `nodeVersion`
+  // and whose `dir` child leads to `key`. Calls visit(parent, parentVersion, dir, child) once the
+  // child is either null or holds `key`; `Again` from the visitor repeats the step at this level.
+  template <typename Visit>
+  Outcome descend(int key, Node* node, int dir, uint32_t nodeVersion, Visit& visit) const {
+    while (true) {
+      Node* child = node->child[dir].load();
+      if (node->version.load() != nodeVersion) {
+        return Outcome::Retry;
+      }
+      if (!child || child->value == key) {
+        Outcome outcome = visit(node, nodeVersion, dir, child);
+        if (outcome != Outcome::Again) {
+          return outcome;
+        }
+        continue;
+      }
+
+      uint32_t childVersion = child->version.load();
+      if (childVersion & (SHRINKING | UNLINKED)) {
+        waitUntilNotShrinking(child);
+        continue;  // An unlinked child has already been replaced in node, so rereading finds the new one
+      }
+      if (child != node->child[dir].load()) {
+        continue;
+      }
+      if (node->version.load() != nodeVersion) {
+        return Outcome::Retry;
+      }
+      Outcome outcome = descend(key, child, key < child->value ? LEFT : RIGHT, childVersion, visit);
+      if (outcome != Outcome::Retry) {
+        return outcome;
+      }
+    }
+  }
+
+  template <typename Visit>
+  bool search(int key, Visit& visit) const {
+    Node* top = const_cast<Node*>(&holder);
+    return descend(key, top, RIGHT, 0, visit) == Outcome::True;
+  }
+
+  static int nodeCondition(const Node* node) {
+    const Node* left = node->child[LEFT].load();
+    const Node* right = node->child[RIGHT].load();
+    if ((!left || !right) && !node->present.load()) {
+      return UNLINK_REQUIRED;
+    }
+    int leftHeight = height(left);
+    int rightHeight = height(right);
+    int balance = leftHeight - rightHeight;
+    if (balance < -1 || balance > 1) {
+      return REBALANCE_REQUIRED;
+    }
+    int newHeight = 1 + std::max(leftHeight, rightHeight);
+    return node->height.load() != newHeight ? newHeight : NOTHING_REQUIRED;
+  }
+
+  // With `node` locked: stores its correct height. Returns the next node to repair (the parent),
+  // `node` itself if it needs a rotation or unlink instead, or nullptr if nothing changed.
+  static Node* fixHeight_nl(Node* node) {
+    int condition = nodeCondition(node);
+    if (condition == REBALANCE_REQUIRED || condition == UNLINK_REQUIRED) {
+      return node;
+    }
+    if (condition == NOTHING_REQUIRED) {
+      return nullptr;
+    }
+    node->height.store(condition);
+    return node->parent.load();
+  }
+
+  static void replaceChild(Node* parent, Node* oldChild, Node* newChild) {
+    int side = parent->child[LEFT].load() == oldChild ? LEFT : RIGHT;
+    parent->child[side].store(newChild);
+  }
+
+  // With `parent` and `node` locked: removes `node`, which has at most one child, from the tree
+  bool attemptUnlink_nl(Node* parent, Node* node) {
+    if (parent->child[LEFT].load() != node && parent->child[RIGHT].load() != node) {
+      return false;
+    }
+    Node* left = node->child[LEFT].load();
+    Node* right = node->child[RIGHT].load();
+    if (left && right) {
+      return false;
+    }
+    Node* splice = left ? left : right;
+    replaceChild(parent, node, splice);
+    if (splice) {
+      splice->parent.store(parent);
+    }
+    node->present.store(false);
+    node->version.store(UNLINKED);
+    epochs.retire(node);
+    return true;
+  }
+
+  // With `parent`, `node` and `heavy` (node's child on side `side`) locked: rotates `heavy` above
+  // `node`. Returns the next node to repair as fixHeight_nl does.
+  Node* rotateSingle_nl(Node* parent, Node* node, Node* heavy, int side, int otherHeight, int outerHeight,
+                        Node* inner, int innerHeight) {
+    int other = 1 - side;
+    uint32_t nodeVersion = node->version.load();
+    node->version.store(beginChange(nodeVersion));
+
+    node->child[side].store(inner);
+    if (inner) {
+      inner->parent.store(node);
+    }
+    heavy->child[other].store(node);
+    node->parent.store(heavy);
+    replaceChild(parent, node, heavy);
+    heavy->parent.store(parent);
+
+    int nodeHeight = 1 + std::max(innerHeight, otherHeight);
+    node->height.store(nodeHeight);
+    heavy->height.store(1 + std::max(outerHeight, nodeHeight));
+    node->version.store(endChange(nodeVersion));
+
+    int nodeBalance = innerHeight - otherHeight;
+    if (nodeBalance < -1 || nodeBalance > 1) {
+      return node;
+    }
+    if ((!inner || otherHeight == 0) && !node->present.load()) {
+      return node;
+    }
+    int heavyBalance = outerHeight - nodeHeight;
+    if (heavyBalance < -1 || heavyBalance > 1) {
+      return heavy;
+    }
+    if (outerHeight == 0 && !heavy->present.load()) {
+      return heavy;
+    }
+    return fixHeight_nl(parent);
+  }
+
+  // With `parent`, `node`, `heavy` and `inner` (heavy's child on the other side) locked: rotates
+  // `inner` above both
+  Node* rotateDouble_nl(Node* parent, Node* node, Node* heavy, int side, int otherHeight, int outerHeight,
+                        Node* inner, int innerSameHeight) {
+    int other = 1 - side;
+    uint32_t nodeVersion = node->version.load();
+    uint32_t heavyVersion = heavy->version.load();
+    Node* innerSame = inner->child[side].load();
+    Node* innerOther = inner->child[other].load();
+    int innerOtherHeight = height(innerOther);
+
+    node->version.store(beginChange(nodeVersion));
+    heavy->version.store(beginChange(heavyVersion));
+
+    node->child[side].store(innerOther);
+    if (innerOther) {
+      innerOther->parent.store(node);
+    }
+    heavy->child[other].store(innerSame);
+    if (innerSame) {
+      innerSame->parent.store(heavy);
+    }
+    inner->child[side].store(heavy);
+    heavy->parent.store(inner);
+    inner->child[other].store(node);
+    node->parent.store(inner);
+    replaceChild(parent, node, inner);
+    inner->parent.store(parent);
+
+    int nodeHeight = 1 + std::max(innerOtherHeight, otherHeight);
+    node->height.store(nodeHeight);
+    int heavyHeight = 1 + std::max(outerHeight, innerSameHeight);
+    heavy->height.store(heavyHeight);
+    inner->height.store(1 + std::max(heavyHeight, nodeHeight));
+
+    node->version.store(endChange(nodeVersion));
+    heavy->version.store(endChange(heavyVersion));
+
+    int nodeBalance = innerOtherHeight - otherHeight;
+    if (nodeBalance < -1 || nodeBalance > 1) {
+      return node;
+    }
+    if ((!innerOther || otherHeight == 0) && !node->present.load()) {
+      return node;
+    }
+    int heavyBalance = outerHeight - innerSameHeight;
+    if (heavyBalance < -1 || heavyBalance > 1) {
+      return heavy;
+    }
+    int innerBalance = heavyHeight - nodeHeight;
+    if (innerBalance < -1 || innerBalance > 1) {
+      return inner;
+    }
+    return fixHeight_nl(parent);
+  }
+
+  // With `parent` and `node` locked, `node` being too tall on side `side`: locks the heavy child
+  // (and its inner grandchild when a double rotation is needed) and rotates
+  Node* rebalanceToward_nl(Node* parent, Node* node, Node* heavy, int side, int otherHeight) {
+    int other = 1 - side;
+    std::lock_guard<SpinLock> heavyLock(heavy->lock);
+    int heavyHeight = heavy->height.load();
+    if (heavyHeight - otherHeight <= 1) {
+      return node;  // Changed since it was measured; recheck
+    }
+    Node* inner = heavy->child[other].load();
+    int outerHeight = height(heavy->child[side].load());
+    int innerHeight = height(inner);
+    if (outerHeight >= innerHeight) {
+      return rotateSingle_nl(parent, node, heavy, side, otherHeight, outerHeight, inner, innerHeight);
+    }
+
+    {
+      std::lock_guard<SpinLock> innerLock(inner->lock);
+      innerHeight = inner->height.load();
+      if (outerHeight >= innerHeight) {
+        return rotateSingle_nl(parent, node, heavy, side, otherHeight, outerHeight, inner, innerHeight);
+      }
+      int innerSameHeight = height(inner->child[side].load());
+      int balance = outerHeight - innerSameHeight;
+      if (balance >= -1 && balance <= 1 && !((outerHeight == 0 || innerSameHeight == 0) && !heavy->present.load())) {
+        return rotateDouble_nl(parent, node, heavy, side, otherHeight, outerHeight, inner, innerSameHeight);
+      }
+    }
+    // The double rotation would leave `heavy` unbalanced, so straighten `heavy` first
+    return rebalanceToward_nl(node, heavy, inner, other, outerHeight);
+  }
+
+  // With `parent` and `node` locked
+  Node* rebalance_nl(Node* parent, Node* node) {
+    Node* left = node->child[LEFT].load();
+    Node* right = node->child[RIGHT].load();
+    if ((!left || !right) && !node->present.load()) {
+      return attemptUnlink_nl(parent, node) ? fixHeight_nl(parent) : node;
+    }
+
+    int leftHeight = height(left);
+    int rightHeight = height(right);
+    int balance = leftHeight - rightHeight;
+    if (balance > 1) {
+      return rebalanceToward_nl(parent, node, left, LEFT, rightHeight);
+    }
+    if (balance < -1) {
+      return rebalanceToward_nl(parent, node, right, RIGHT, leftHeight);
+    }
+    int newHeight = 1 + std::max(leftHeight, rightHeight);
+    if (node->height.load() != newHeight) {
+      node->height.store(newHeight);
+      return fixHeight_nl(parent);
+    }
+    return nullptr;
+  }
+
+  // Walks up from a changed node repairing heights, rotating and unlinking routing nodes
+  void fixHeightAndRebalance(Node* node) {
+    while (node && node->parent.load()) {
+      int condition = nodeCondition(node);
+      if (condition == NOTHING_REQUIRED || (node->version.load() & UNLINKED)) {
+        return;
+      }
+      if (condition != UNLINK_REQUIRED && condition != REBALANCE_REQUIRED) {
+        std::lock_guard<SpinLock> nodeLock(node->lock);
+        node = fixHeight_nl(node);
+      } else {
+        Node* parent = node->parent.load();
+        std::lock_guard<SpinLock> parentLock(parent->lock);
+        if (!(parent->version.load() & UNLINKED) && node->parent.load() == parent) {
+          std::lock_guard<SpinLock> nodeLock(node->lock);
+          node = rebalance_nl(parent, node);
+        }
+        // Otherwise the parent changed under us; look again
+      }
+    }
+  }
+
+ public:
+  ConcurrentAVLTree()
+      : holder(0, nullptr) {
+  }
+
+  ConcurrentAVLTree(const ConcurrentAVLTree&) = delete;
+  ConcurrentAVLTree& operator=(const ConcurrentAVLTree&) = delete;
+
+  // No other thread may still be using the tree
+  ~ConcurrentAVLTree() {
+    std::vector<Node*> stack;
+    if (Node* root = holder.child[RIGHT].load()) {
+      stack.push_back(root);
+    }
+    while (!stack.empty()) {
+      Node* node = stack.back();
+      stack.pop_back();
+      for (int side : {LEFT, RIGHT}) {
+        if (Node* next = node->child[side].load()) {
+          stack.push_back(next);
+        }
+      }
+      delete node;
+    }
+  }
+
+  // Returns false if `value` was already present
+  bool insert(int value) {
+    EpochDomain::Guard guard(epochs);
+    auto visit = [&](Node* parent, uint32_t parentVersion, int dir, Node* child) {
+      if (child) {
+        if (child->present.load()) {
+          return Outcome::False;
+        }
+        std::lock_guard<SpinLock> childLock(child->lock);
+        if (child->version.load() & UNLINKED) {
+          return Outcome::Again;
+        }
+        if (child->present.load()) {
+          return Outcome::False;
+        }
+        child->present.store(true);  // Revive a routing node
+        return Outcome::True;
+      }
+
+      {
+        std::lock_guard<SpinLock> parentLock(parent->lock);
+        if (parent->version.load() != parentVersion) {
+          return Outcome::Retry;
+        }
+        if (parent->child[dir].load()) {
+          return Outcome::Again;  // Another insert got there first
+        }
+        parent->child[dir].store(new Node(value, parent));
+      }
+      fixHeightAndRebalance(parent);
+      return Outcome::True;
+    };
+    bool inserted = search(value, visit);
+    if (inserted) {
+      count.fetch_add(1, std::memory_order_relaxed);
+    }
+    return inserted;
+  }
+
+  bool contains(int value) const {
+    EpochDomain::Guard guard(epochs);
+    auto visit = [](Node*, uint32_t, int, Node* child) {
+      return child && child->present.load() ? Outcome::True : Outcome::False;
+    };
+    return search(value, visit);
+  }
+
+  // Returns false if `value` was not present
+  bool deleteNode(int value) {
+    EpochDomain::Guard guard(epochs);
+    auto visit = [&](Node* parent, uint32_t, int, Node* child) {
+      if (!child || !child->present.load()) {
+        return Outcome::False;
+      }
+      if (child->child[LEFT].load() && child->child[RIGHT].load()) {
+        std::lock_guard<SpinLock> childLock(child->lock);
+        if (child->version.load() & UNLINKED) {
+          return Outcome::Again;
+        }
+        if (!child->present.load()) {
+          return Outcome::False;
+        }
+        if (child->child[LEFT].load() && child->child[RIGHT].load()) {
+          child->present.store(false);  // Stays in place as a routing node
+          return Outcome::True;
+        }
+        // Lost a child meanwhile, so it can be unlinked after all
+      }
+
+      {
+        std::lock_guard<SpinLock> parentLock(parent->lock);
+        if ((parent->version.load() & UNLINKED) || child->parent.load() != parent) {
+          return Outcome::Again;
+        }
+        std::lock_guard<SpinLock> childLock(child->lock);
+        if (!child->present.load()) {
+          return Outcome::False;
+        }
+        if (!attemptUnlink_nl(parent, child)) {
+          child->present.store(false);  // Gained a second child meanwhile
+          return Outcome::True;
+        }
+      }
+      fixHeightAndRebalance(parent);
+      return Outcome::True;
+    };
+    bool removed = search(value, visit);
+    if (removed) {
+      count.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return removed;
+  }
+
+  // Exact when no update is in flight
+  size_t size() const {
+    return count.load(std::memory_order_relaxed);
+  }
+
+  // Keys in ascending order. Only meaningful while no other thread is updating the tree.
+  std::vector<int> toSortedVector() const {
+    std::vector<int> keys;
+    std::vector<const Node*> stack;
+    const Node* node = holder.child[RIGHT].load();
+    while (node || !stack.empty()) {
+      while (node) {
+        stack.push_back(node);
+        node = node->child[LEFT].load();
+      }
+      node = stack.back();
+      stack.pop_back();
+      if (node->present.load()) {
+        keys.push_back(node->value);
+      }
+      node = node->child[RIGHT].load();
+    }
+    return keys;
+  }
+
+  // Number of levels, routing nodes included. Only meaningful while no update is in flight.
+  int height() const {
+    return height(holder.child[RIGHT].load());
+  }
+};
+
+#endif  // CONCURRENT_AVL_TREE_H
@@ -0,0 +1,353 @@
+#ifndef PERSISTENT_AVL_TREE_H
+#define PERSISTENT_AVL_TREE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "StaticIndex.h"
+#include "TreePrinter.h"
+
+// Nodes never change once they are linked into a tree, so any number of versions can share them.
+// Each node counts the parents and roots that point at it and is freed when the count drops to 0.
+struct PersistentAVLNode {
+  const int value;
+  const int height;
+  std::atomic<uint32_t> references;
+  PersistentAVLNode* const left;
+  PersistentAVLNode* const right;
+
+  PersistentAVLNode(int v, int h, PersistentAVLNode* l, PersistentAVLNode* r)
+      : value(v), height(h), references(1), left(l), right(r) {
+  }
+};
+
+// Ordered set of ints with O(1) snapshots. insert and deleteNode copy the O(log n) nodes on the
+// path to the change (plus the few a rotation touches) and share every other subtree with the
+// previous version, which stays intact for any Snapshot still holding it.
+//
+// One thread at a time may modify or read the tree itself. snapshot() may be called from any
+// thread while it does; other threads read through snapshots, which can be used and dropped
+// anywhere. Nodes are separate heap allocations because they are released by whichever thread
+// drops the last version that uses them.
+class PersistentAVLTree {
+  using Node = PersistentAVLNode;
+
+  // Shared by the tree and its snapshots, so the node count stays right whichever one releases
+  // the last reference
+  using NodeCounter = std::shared_ptr<std::atomic<size_t>>;
+
+  Node* root = nullptr;
+  size_t count = 0;
+  NodeCounter liveNodes = std::make_shared<std::atomic<size_t>>(0);
+  std::mutex rootLock;  // Only guards swapping root and count against snapshot()
+
+  static int getHeight(const Node* node) {
+    return node ? node->height : 0;
+  }
+
+  static Node* share(Node* node) {
+    if (node) {
+      node->references.fetch_add(1, std::memory_order_relaxed);
+    }
+    return node;
+  }
+
+  static void release(Node* node, std::atomic<size_t>& nodes) {
+    while (node && node->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      release(node->left, nodes);
+      Node* right = node->right;
+      delete node;
+      nodes.fetch_sub(1, std::memory_order_relaxed);
+      node = right;
+    }
+  }
+
+  // Takes over the references to `left` and `right`
+  Node* make(int value, Node* left, Node* right) {
+    liveNodes->fetch_add(1, std::memory_order_relaxed);
+    return new Node(value, std::max(getHeight(left), getHeight(right)) + 1, left, right);
+  }
+
+  // Builds a balanced node from `value` and two owned subtrees whose heights differ by at most 2.
+  // A rotation re-creates the nodes it moves instead of changing them.
+  Node* balance(int value, Node* left, Node* right) {
+    int heightLeft = getHeight(left);
+    int heightRight = getHeight(right);
+
+    if (heightLeft > heightRight + 1) {
+      Node* result;
+      if (getHeight(left->left) >= getHeight(left->right)) {
+        // Left Left Case
+        result = make(left->value, share(left->left), make(value, share(left->right), right));
+      } else {
+        // Left Right Case
+        Node* middle = left->right;
+        result = make(middle->value, make(left->value, share(left->left), share(middle->left)),
+                      make(value, share(middle->right), right));
+      }
+      release(left, *liveNodes);
+      return result;
+    }
+
+    if (heightRight > heightLeft + 1) {
+      Node* result;
+      if (getHeight(right->right) >= getHeight(right->left)) {
+        // Right Right Case
+        result = make(right->value, make(value, left, share(right->left)), share(right->right));
+      } else {
+        // Right Left Case
+        Node* middle = right->left;
+        result = make(middle->value, make(value, left, share(middle->left)),
+                      make(right->value, share(middle->right), share(right->right)));
+      }
+      release(right, *liveNodes);
+      return result;
+    }
+
+    return make(value, left, right);
+  }
+
+  // New version of `node`'s subtree with `value` added, or nullptr if it is already there
+  Node* insert(Node* node, int value) {
+    if (!node) {
+      return make(value, nullptr, nullptr);
+    }
+    if (value < node->value) {
+      Node* left = insert(node->left, value);
+      return left ? balance(node->value, left, share(node->right)) : nullptr;
+    }
+    if (value > node->value) {
+      Node* right = insert(node->right, value);
+      return right ? balance(node->value, share(node->left), right) : nullptr;
+    }
+    return nullptr;
+  }
+
+  // New version of `node`'s subtree without `value`; `found` tells whether there was anything to
+  // remove (if not, the result is nullptr and means nothing)
+  Node* erase(Node* node, int value, bool& found) {
+    if (!node) {
+      found = false;
+      return nullptr;
+    }
+    if (value < node->value) {
+      Node* left = erase(node->left, value, found);
+      return found ? balance(node->value, left, share(node->right)) : nullptr;
+    }
+    if (value > node->value) {
+      Node* right = erase(node->right, value, found);
+      return found ? balance(node->value, share(node->left), right) : nullptr;
+    }
+
+    found = true;
+    if (!node->left || !node->right) {
+      return share(node->left ? node->left : node->right);
+    }
+    const Node* successor = node->right;
+    while (successor->left) {
+      successor = successor->left;
+    }
+    Node* right = erase(node->right, successor->value, found);
+    return balance(successor->value, share(node->left), right);
+  }
+
+  // Publishes a new version and drops the current one, unless a snapshot still holds it
+  void replaceRoot(Node* newRoot, size_t newCount) {
+    Node* old;
+    {
+      std::lock_guard<std::mutex> lock(rootLock);
+      old = std::exchange(root, newRoot);
+      count = newCount;
+    }
+    release(old, *liveNodes);
+  }
+
+  static bool contains(const Node* node, int value) {
+    while (node && node->value != value) {
+      node = value < node->value ? node->left : node->right;
+    }
+    return node != nullptr;
+  }
+
+  static std::optional<int> lowerBound(const Node* node, int value) {
+    std::optional<int> result;
+    while (node) {
+      if (node->value < value) {
+        node = node->right;
+      } else {
+        result = node->value;
+        node = node->left;
+      }
+    }
+    return result;
+  }
+
+  template <typename Visit>
+  static void forEachInRange(const Node* node, int low, int high, Visit& visit) {
+    if (!node) {
+      return;
+    }
+    if (low < node->value) {
+      forEachInRange(node->left, low, high, visit);
+    }
+    if (low <= node->value && node->value <= high) {
+      visit(node->value);
+    }
+    if (node->value < high) {
+      forEachInRange(node->right, low, high, visit);
+    }
+  }
+
+ public:
+  // Read-only view of the tree as it was when the snapshot was taken. Copying one is O(1).
+  class Snapshot {
+    Node* root;
+    size_t count;
+    NodeCounter liveNodes;
+
+    friend class PersistentAVLTree;
+
+    Snapshot(Node* root, size_t count, NodeCounter liveNodes)
+        : root(root), count(count), liveNodes(std::move(liveNodes)) {
+    }
+
+   public:
+    Snapshot(const Snapshot& other)
+        : root(share(other.root)), count(other.count), liveNodes(other.liveNodes) {
+    }
+
+    Snapshot(Snapshot&& other) noexcept
+        : root(std::exchange(other.root, nullptr)), count(other.count), liveNodes(other.liveNodes) {
+    }
+
+    Snapshot& operator=(Snapshot other) noexcept {
+      std::swap(root, other.root);
+      std::swap(count, other.count);
+      std::swap(liveNodes, other.liveNodes);
+      return *this;
+    }
+
+    ~Snapshot() {
+      release(root, *liveNodes);
+    }
+
+    bool contains(int value) const {
+      return PersistentAVLTree::contains(root, value);
+    }
+
+    // Smallest key that is not less than `value`, if any
+    std::optional<int> lowerBound(int value) const {
+      return PersistentAVLTree::lowerBound(root, value);
+    }
+
+    // Calls visit(key) for every key in [low, high] in ascending order
+    template <typename Visit>
+    void forEachInRange(int low, int high, Visit&& visit) const {
+      PersistentAVLTree::forEachInRange(root, low, high, visit);
+    }
+
+    size_t size() const {
+      return count;
+    }
+
+    int height() const {
+      return getHeight(root);
+    }
+
+    std::vector<int> toSortedVector() const {
+      return collectInorder(root, count);
+    }
+  };
+
+  PersistentAVLTree() = default;
+
+  PersistentAVLTree(const PersistentAVLTree&) = delete;
+  PersistentAVLTree& operator=(const PersistentAVLTree&) = delete;
+
+  // Snapshots keep their versions alive on their own
+  ~PersistentAVLTree() {
+    release(root, *liveNodes);
+  }
+
+  // Returns false if `value` was already present
+  bool insert(int value) {
+    Node* newRoot = insert(root, value);
+    if (!newRoot) {
+      return false;
+    }
+    replaceRoot(newRoot, count + 1);
+    return true;
+  }
+
+  // Returns false if `value` was not present
+  bool deleteNode(int value) {
+    bool found = false;
+    Node* newRoot = erase(root, value, found);
+    if (!found) {
+      return false;
+    }
+    replaceRoot(newRoot, count - 1);
+    return true;
+  }
+
+  // The current version, kept alive (and unchanged) for as long as the snapshot exists. O(1).
+  Snapshot snapshot() {
+    std::lock_guard<std::mutex> lock(rootLock);
+    return Snapshot(share(root), count, liveNodes);
+  }
+
+  bool contains(int value) const {
+    return contains(root, value);
+  }
+
+  std::optional<int> lowerBound(int value) const {
+    return lowerBound(root, value);
+  }
+
+  template <typename Visit>
+  void forEachInRange(int low, int high, Visit&& visit) const {
+    forEachInRange(root, low, high, visit);
+  }
+
+  size_t size() const {
+    return count;
+  }
+
+  int height() const {
+    return getHeight(root);
+  }
+
+  // Nodes held by the current version and every live snapshot together, each shared node once
+  size_t nodesAllocated() const {
+    return liveNodes->load(std::memory_order_relaxed);
+  }
+
+  size_t bytesAllocated() const {
+    return nodesAllocated() * sizeof(Node);
+  }
+
+  std::vector<int> toSortedVector() const {
+    return collectInorder(root, count);
+  }
+
+  void printTree() const {
+    if (!root) {
+      std::cout << "Puste drzewo\n";
+      return;
+    }
+    std::vector<std::vector<std::string>> result = treeToMatrix(root);
+
+    print2DArray(result);
+  }
+};
+
+#endif  // PERSISTENT_AVL_TREE_H
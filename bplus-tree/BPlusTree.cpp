@@ -0,0 +1,37 @@
+#include <iostream>
+#include <vector>
+
+#include "BPlusTree.h"
+
+int main() {
+  // Two cache lines per node keeps the demo tree a few levels deep
+  BPlusTree<2> tree;
+
+  for (int value = 1; value <= 200; value += 3) {
+    tree.insert(value);
+  }
+  tree.printTree();
+
+  std::cout << "Zawiera 10: " << (tree.contains(10) ? "Tak" : "Nie") << std::endl;
+  std::cout << "Zawiera 26: " << (tree.contains(26) ? "Tak" : "Nie") << std::endl;
+  std::cout << "Liczba elementow w [10, 40]: " << tree.countInRange(10, 40) << std::endl;
+
+  std::cout << "Elementy w [20, 30]:";
+  tree.forEachInRange(20, 30, [](int value) { std::cout << " " << value; });
+  std::cout << std::endl;
+
+  for (int value = 1; value <= 150; value += 3) {
+    tree.deleteNode(value);
+  }
+  tree.printTree();
+
+  std::vector<int> squares;
+  for (int i = 1; i <= 40; i++) {
+    squares.push_back(i * i);
+  }
+  BPlusTree<2> loaded = BPlusTree<2>::fromSorted(squares.begin(), squares.end());
+  std::cout << "Kwadraty:\n";
+  loaded.printTree();
+
+  return 0;
+}
@@ -0,0 +1,627 @@
+#ifndef BPLUS_TREE_H
+#define BPLUS_TREE_H
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "NodePool.h"
+
+// Ordered set of ints as a B+tree. Every node is `CacheLines` cache lines long, so one node visit
+// costs a few adjacent line fills (which the hardware prefetcher streams) instead of the one miss
+// per level that a binary tree pays. Keys live only in the leaves, which are linked left to right
+// for range scans; inner nodes hold separator keys, child i covering [keys[i - 1], keys[i]).
+//
+// Searching inside a node compares eight keys per instruction with AVX2 (four with SSE2, plain
+// loop otherwise). Key slots past a node's count always hold INT_MAX, so the vector loop needs no
+// tail handling.
+//
+// Deletion merges a node that falls below half full with a sibling, or borrows a key from it
+// when the sibling has spare ones, so every node except the root stays at least half full.
+
+namespace bplus {
+
+constexpr size_t LINE = 64;
+constexpr size_t LANES = 8;  // Key slots are allocated in blocks of one AVX2 vector
+
+constexpr size_t roundUpToLanes(size_t keys) {
+  return (keys + LANES - 1) / LANES * LANES;
+}
+
+// Largest leaf capacity whose keys, next pointer and count fit in `bytes`
+constexpr size_t leafCapacity(size_t bytes) {
+  size_t capacity = 0;
+  while (roundUpToLanes(capacity + 1) * sizeof(int) + sizeof(void*) + sizeof(uint64_t) <= bytes) {
+    capacity++;
+  }
+  return capacity;
+}
+
+// Largest inner capacity whose keys, capacity + 1 children and count fit in `bytes`
+constexpr size_t innerCapacity(size_t bytes) {
+  size_t capacity = 0;
+  while (roundUpToLanes(capacity + 1) * sizeof(int) + (capacity + 2) * sizeof(void*) + sizeof(uint64_t) <= bytes) {
+    capacity++;
+  }
+  return capacity;
+}
+
+// Number of keys[0..count) less than `key`. Relies on keys[count..) being INT_MAX up to the end of
+// the current vector block.
+inline size_t countLess(const int* keys, size_t count, int key) {
+  size_t result = 0;
+#if defined(__AVX2__)
+  __m256i needle = _mm256_set1_epi32(key);
+  for (size_t i = 0; i < count; i += 8) {
+    __m256i block = _mm256_load_si256(reinterpret_cast<const __m256i*>(keys + i));
+    int less = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(needle, block)));
+    result += __builtin_popcount(less);
+    if (less != 0xFF) {
+      break;  // Keys are sorted, so the rest are not less either
+    }
+  }
+#elif defined(__SSE2__)
+  __m128i needle = _mm_set1_epi32(key);
+  for (size_t i = 0; i < count; i += 4) {
+    __m128i block = _mm_load_si128(reinterpret_cast<const __m128i*>(keys + i));
+    int less = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(needle, block)));
+    result += __builtin_popcount(less);
+    if (less != 0xF) {
+      break;
+    }
+  }
+#else
+  while (result < count && keys[result] < key) {
+    result++;
+  }
+#endif
+  return result;
+}
+
+// Number of keys[0..count) not greater than `key`
+inline size_t countNotGreater(const int* keys, size_t count, int key) {
+  if (key == INT_MAX) {
+    return count;  // The padding would match too
+  }
+  return countLess(keys, count, key + 1);
+}
+
+}  // namespace bplus
+
+template <size_t CacheLines = 4>
+class BPlusTree {
+  static constexpr size_t NODE_BYTES = CacheLines * bplus::LINE;
+
+ public:
+  static constexpr size_t LEAF_CAPACITY = bplus::leafCapacity(NODE_BYTES);
+  static constexpr size_t INNER_CAPACITY = bplus::innerCapacity(NODE_BYTES);
+
+ private:
+  static_assert(INNER_CAPACITY >= 3, "BPlusTree nodes need at least two cache lines");
+
+  static constexpr size_t LEAF_MIN = LEAF_CAPACITY / 2;
+  static constexpr size_t INNER_MIN = INNER_CAPACITY / 2;
+
+  struct alignas(bplus::LINE) Leaf {
+    int keys[bplus::roundUpToLanes(LEAF_CAPACITY)];
+    Leaf* next;
+    uint64_t count;
+
+    Leaf()
+        : next(nullptr), count(0) {
+      std::fill(std::begin(keys), std::end(keys), INT_MAX);
+    }
+  };
+
+  struct alignas(bplus::LINE) Inner {
+    int keys[bplus::roundUpToLanes(INNER_CAPACITY)];
+    void* children[INNER_CAPACITY + 1];  // Inner nodes above level 1, leaves at level 1
+    uint64_t count;                      // Number of keys; there is one more child
+
+    Inner()
+        : count(0) {
+      std::fill(std::begin(keys), std::end(keys), INT_MAX);
+    }
+  };
+
+  static_assert(sizeof(Leaf) == NODE_BYTES, "Leaf must fill its cache lines exactly");
+  static_assert(sizeof(Inner) == NODE_BYTES, "Inner node must fill its cache lines exactly");
+
+  struct Split {
+    int separator;
+    void* right = nullptr;
+  };
+
+  void* root = nullptr;
+  size_t levels = 0;  // Inner levels above the leaves
+  size_t count = 0;
+  NodePool<Leaf> leaves;
+  NodePool<Inner> inners;
+
+  static Leaf* asLeaf(void* node) {
+    return static_cast<Leaf*>(node);
+  }
+
+  static Inner* asInner(void* node) {
+    return static_cast<Inner*>(node);
+  }
+
+  static const Leaf* asLeaf(const void* node) {
+    return static_cast<const Leaf*>(node);
+  }
+
+  static const Inner* asInner(const void* node) {
+    return static_cast<const Inner*>(node);
+  }
+
+  // Moves keys[from..count) up by one slot; the caller then writes keys[from] and bumps count
+  static void openGap(int* keys, size_t count, size_t from) {
+    std::memmove(keys + from + 1, keys + from, (count - from) * sizeof(int));
+  }
+
+  // Removes keys[at], refilling the freed slot at the end with padding
+  static void closeGap(int* keys, size_t count, size_t at) {
+    std::memmove(keys + at, keys + at + 1, (count - at - 1) * sizeof(int));
+    keys[count - 1] = INT_MAX;
+  }
+
+  static void openChildGap(void** children, size_t childCount, size_t from) {
+    std::memmove(children + from + 1, children + from, (childCount - from) * sizeof(void*));
+  }
+
+  static void closeChildGap(void** children, size_t childCount, size_t at) {
+    std::memmove(children + at, children + at + 1, (childCount - at - 1) * sizeof(void*));
+  }
+
+  const Leaf* findLeaf(int key) const {
+    const void* node = root;
+    for (size_t level = levels; level > 0; level--) {
+      const Inner* inner = asInner(node);
+      node = inner->children[bplus::countNotGreater(inner->keys, inner->count, key)];
+    }
+    return asLeaf(node);
+  }
+
+  bool insertIntoLeaf(Leaf* leaf, int key, Split& split) {
+    size_t position = bplus::countLess(leaf->keys, leaf->count, key);
+    if (position < leaf->count && leaf->keys[position] == key) {
+      return false;
+    }
+
+    if (leaf->count == LEAF_CAPACITY) {
+      Leaf* right = leaves.create();
+      size_t keep = (LEAF_CAPACITY + 1) / 2;
+      right->count = LEAF_CAPACITY - keep;
+      std::copy(leaf->keys + keep, leaf->keys + LEAF_CAPACITY, right->keys);
+      std::fill(leaf->keys + keep, leaf->keys + LEAF_CAPACITY, INT_MAX);
+      leaf->count = keep;
+      right->next = leaf->next;
+      leaf->next = right;
+
+      if (position > keep) {
+        leaf = right;
+        position -= keep;
+      }
+      split.right = right;
+    }
+
+    openGap(leaf->keys, leaf->count, position);
+    leaf->keys[position] = key;
+    leaf->count++;
+    if (split.right) {
+      split.separator = asLeaf(split.right)->keys[0];
+    }
+    return true;
+  }
+
+  // Adds separator/right as the entry after children[index], splitting `inner` when it is full
+  void insertIntoInner(Inner* inner, size_t index, const Split& child, Split& split) {
+    if (inner->count < INNER_CAPACITY) {
+      openGap(inner->keys, inner->count, index);
+      openChildGap(inner->children, inner->count + 1, index + 1);
+      inner->keys[index] = child.separator;
+      inner->children[index + 1] = child.right;
+      inner->count++;
+      return;
+    }
+
+    // Lay out all CAPACITY + 1 keys in order, then hand the upper part to a new node
+    int keys[INNER_CAPACITY + 1];
+    void* children[INNER_CAPACITY + 2];
+    std::copy(inner->keys, inner->keys + index, keys);
+    keys[index] = child.separator;
+    std::copy(inner->keys + index, inner->keys + INNER_CAPACITY, keys + index + 1);
+    std::copy(inner->children, inner->children + index + 1, children);
+    children[index + 1] = child.right;
+    std::copy(inner->children + index + 1, inner->children + INNER_CAPACITY + 1, children + index + 2);
+
+    size_t keep = (INNER_CAPACITY + 1) / 2;
+    Inner* right = inners.create();
+    right->count = INNER_CAPACITY - keep;
+    std::copy(keys + keep + 1, keys + INNER_CAPACITY + 1, right->keys);
+    std::copy(children + keep + 1, children + INNER_CAPACITY + 2, right->children);
+
+    std::copy(keys, keys + keep, inner->keys);
+    std::fill(inner->keys + keep, std::end(inner->keys), INT_MAX);
+    std::copy(children, children + keep + 1, inner->children);
+    inner->count = keep;
+
+    split.separator = keys[keep];  // Moves up instead of staying in either half
+    split.right = right;
+  }
+
+  bool insert(void* node, size_t level, int key, Split& split) {
+    if (level == 0) {
+      return insertIntoLeaf(asLeaf(node), key, split);
+    }
+    Inner* inner = asInner(node);
+    size_t index = bplus::countNotGreater(inner->keys, inner->count, key);
+    Split child;
+    bool inserted = insert(inner->children[index], level - 1, key, child);
+    if (child.right) {
+      insertIntoInner(inner, index, child, split);
+    }
+    return inserted;
+  }
+
+  // Restores the minimum fill of leaf children[index] of `parent` by borrowing from or merging
+  // with a neighbour
+  void rebalanceLeaf(Inner* parent, size_t index) {
+    Leaf* leaf = asLeaf(parent->children[index]);
+    if (index > 0) {
+      Leaf* left = asLeaf(parent->children[index - 1]);
+      if (left->count > LEAF_MIN) {
+        openGap(leaf->keys, leaf->count, 0);
+        leaf->keys[0] = left->keys[left->count - 1];
+        leaf->count++;
+        left->keys[--left->count] = INT_MAX;
+        parent->keys[index - 1] = leaf->keys[0];
+        return;
+      }
+      mergeLeaves(parent, index - 1);
+      return;
+    }
+    Leaf* right = asLeaf(parent->children[index + 1]);
+    if (right->count > LEAF_MIN) {
+      leaf->keys[leaf->count++] = right->keys[0];
+      closeGap(right->keys, right->count, 0);
+      right->count--;
+      parent->keys[index] = right->keys[0];
+      return;
+    }
+    mergeLeaves(parent, index);
+  }
+
+  // Appends leaf children[index + 1] to children[index] and drops it from `parent`
+  void mergeLeaves(Inner* parent, size_t index) {
+    Leaf* left = asLeaf(parent->children[index]);
+    Leaf* right = asLeaf(parent->children[index + 1]);
+    std::copy(right->keys, right->keys + right->count, left->keys + left->count);
+    left->count += right->count;
+    left->next = right->next;
+    leaves.destroy(right);
+    closeGap(parent->keys, parent->count, index);
+    closeChildGap(parent->children, parent->count + 1, index + 1);
+    parent->count--;
+  }
+
+  void rebalanceInner(Inner* parent, size_t index) {
+    Inner* inner = asInner(parent->children[index]);
+    if (index > 0) {
+      Inner* left = asInner(parent->children[index - 1]);
+      if (left->count > INNER_MIN) {
+        // Rotate right through the parent: its separator comes down, left's last key goes up
+        openGap(inner->keys, inner->count, 0);
+        openChildGap(inner->children, inner->count + 1, 0);
+        inner->keys[0] = parent->keys[index - 1];
+        inner->children[0] = left->children[left->count];
+        inner->count++;
+        parent->keys[index - 1] = left->keys[left->count - 1];
+        left->keys[--left->count] = INT_MAX;
+        return;
+      }
+      mergeInners(parent, index - 1);
+      return;
+    }
+    Inner* right = asInner(parent->children[index + 1]);
+    if (right->count > INNER_MIN) {
+      inner->keys[inner->count] = parent->keys[index];
+      inner->children[inner->count + 1] = right->children[0];
+      inner->count++;
+      parent->keys[index] = right->keys[0];
+      closeGap(right->keys, right->count, 0);
+      closeChildGap(right->children, right->count + 1, 0);
+      right->count--;
+      return;
+    }
+    mergeInners(parent, index);
+  }
+
+  void mergeInners(Inner* parent, size_t index) {
+    Inner* left = asInner(parent->children[index]);
+    Inner* right = asInner(parent->children[index + 1]);
+    left->keys[left->count] = parent->keys[index];
+    std::copy(right->keys, right->keys + right->count, left->keys + left->count + 1);
+    std::copy(right->children, right->children + right->count + 1, left->children + left->count + 1);
+    left->count += right->count + 1;
+    inners.destroy(right);
+    closeGap(parent->keys, parent->count, index);
+    closeChildGap(parent->children, parent->count + 1, index + 1);
+    parent->count--;
+  }
+
+  bool erase(void* node, size_t level, int key) {
+    if (level == 0) {
+      Leaf* leaf = asLeaf(node);
+      size_t position = bplus::countLess(leaf->keys, leaf->count, key);
+      if (position == leaf->count || leaf->keys[position] != key) {
+        return false;
+      }
+      closeGap(leaf->keys, leaf->count, position);
+      leaf->count--;
+      return true;
+    }
+
+    Inner* inner = asInner(node);
+    size_t index = bplus::countNotGreater(inner->keys, inner->count, key);
+    if (!erase(inner->children[index], level - 1, key)) {
+      return false;
+    }
+    if (level == 1) {
+      if (asLeaf(inner->children[index])->count < LEAF_MIN) {
+        rebalanceLeaf(inner, index);
+      }
+    } else if (asInner(inner->children[index])->count < INNER_MIN) {
+      rebalanceInner(inner, index);
+    }
+    return true;
+  }
+
+  // Groups `nodes` (each with its smallest key) under new inner nodes, spreading them evenly so
+  // every parent gets at least INNER_MIN + 1 children
+  std::vector<std::pair<void*, int>> buildLevel(const std::vector<std::pair<void*, int>>& nodes) {
+    size_t parents = (nodes.size() + INNER_CAPACITY) / (INNER_CAPACITY + 1);
+    std::vector<std::pair<void*, int>> level;
+    level.reserve(parents);
+    size_t next = 0;
+    for (size_t p = 0; p < parents; p++) {
+      size_t children = nodes.size() / parents + (p < nodes.size() % parents ? 1 : 0);
+      Inner* inner = inners.create();
+      level.emplace_back(inner, nodes[next].second);
+      inner->children[0] = nodes[next++].first;
+      for (size_t c = 1; c < children; c++) {
+        inner->keys[c - 1] = nodes[next].second;
+        inner->children[c] = nodes[next++].first;
+      }
+      inner->count = children - 1;
+    }
+    return level;
+  }
+
+  static void printNode(const void* node, size_t level) {
+    const int* keys = level == 0 ? asLeaf(node)->keys : asInner(node)->keys;
+    size_t keyCount = level == 0 ? asLeaf(node)->count : asInner(node)->count;
+    std::cout << "[";
+    for (size_t i = 0; i < keyCount; i++) {
+      std::cout << (i ? " " : "") << keys[i];
+    }
+    std::cout << "] ";
+  }
+
+ public:
+  BPlusTree() = default;
+  BPlusTree(const BPlusTree&) = delete;
+  BPlusTree& operator=(const BPlusTree&) = delete;
+
+  BPlusTree(BPlusTree&& other) noexcept
+      : root(std::exchange(other.root, nullptr)),
+        levels(std::exchange(other.levels, 0)),
+        count(std::exchange(other.count, 0)),
+        leaves(std::move(other.leaves)),
+        inners(std::move(other.inners)) {
+  }
+
+  BPlusTree& operator=(BPlusTree&& other) noexcept {
+    root = std::exchange(other.root, nullptr);
+    levels = std::exchange(other.levels, 0);
+    count = std::exchange(other.count, 0);
+    leaves = std::move(other.leaves);
+    inners = std::move(other.inners);
+    return *this;
+  }
+
+  // Builds the tree bottom-up in O(n) from strictly increasing keys (std::invalid_argument
+  // otherwise). Leaves and inner nodes are filled evenly and as full as possible.
+  template <typename It>
+  static BPlusTree fromSorted(It first, It last) {
+    BPlusTree tree;
+    size_t n = static_cast<size_t>(std::distance(first, last));
+    if (n == 0) {
+      return tree;
+    }
+
+    size_t leafCount = (n + LEAF_CAPACITY - 1) / LEAF_CAPACITY;
+    std::vector<std::pair<void*, int>> level;
+    level.reserve(leafCount);
+    Leaf* previous = nullptr;
+    bool havePrevious = false;
+    int previousKey = 0;
+    for (size_t l = 0; l < leafCount; l++) {
+      Leaf* leaf = tree.leaves.create();
+      leaf->count = n / leafCount + (l < n % leafCount ? 1 : 0);
+      for (size_t i = 0; i < leaf->count; i++, ++first) {
+        int key = *first;
+        if (havePrevious && key <= previousKey) {
+          throw std::invalid_argument("BPlusTree::fromSorted: keys must be strictly increasing");
+        }
+        leaf->keys[i] = previousKey = key;
+        havePrevious = true;
+      }
+      if (previous) {
+        previous->next = leaf;
+      }
+      previous = leaf;
+      level.emplace_back(leaf, leaf->keys[0]);
+    }
+
+    while (level.size() > 1) {
+      level = tree.buildLevel(level);
+      tree.levels++;
+    }
+    tree.root = level[0].first;
+    tree.count = n;
+    return tree;
+  }
+
+  void insert(int key) {
+    if (!root) {
+      root = leaves.create();
+    }
+    Split split;
+    if (insert(root, levels, key, split)) {
+      count++;
+    }
+    if (split.right) {
+      Inner* top = inners.create();
+      top->keys[0] = split.separator;
+      top->children[0] = root;
+      top->children[1] = split.right;
+      top->count = 1;
+      root = top;
+      levels++;
+    }
+  }
+
+  bool contains(int key) const {
+    if (!root) {
+      return false;
+    }
+    const Leaf* leaf = findLeaf(key);
+    size_t position = bplus::countLess(leaf->keys, leaf->count, key);
+    return position < leaf->count && leaf->keys[position] == key;
+  }
+
+  // Smallest key that is not less than `key`, if any
+  std::optional<int> lowerBound(int key) const {
+    if (!root) {
+      return std::nullopt;
+    }
+    const Leaf* leaf = findLeaf(key);
+    size_t position = bplus::countLess(leaf->keys, leaf->count, key);
+    if (position == leaf->count) {
+      leaf = leaf->next;  // Every key in the next leaf is greater
+      position = 0;
+    }
+    return leaf ? std::optional<int>(leaf->keys[position]) : std::nullopt;
+  }
+
+  // Calls visit(key) for every key in [low, high] in ascending order, walking the leaf chain
+  template <typename Visit>
+  void forEachInRange(int low, int high, Visit&& visit) const {
+    if (!root || low > high) {
+      return;
+    }
+    const Leaf* leaf = findLeaf(low);
+    size_t position = bplus::countLess(leaf->keys, leaf->count, low);
+    for (; leaf; leaf = leaf->next, position = 0) {
+      for (; position < leaf->count; position++) {
+        if (leaf->keys[position] > high) {
+          return;
+        }
+        visit(leaf->keys[position]);
+      }
+    }
+  }
+
+  // Number of keys in [low, high]. Whole leaves inside the range are counted without being read.
+  size_t countInRange(int low, int high) const {
+    if (!root || low > high) {
+      return 0;
+    }
+    const Leaf* leaf = findLeaf(low);
+    size_t result = 0;
+    size_t position = bplus::countLess(leaf->keys, leaf->count, low);
+    while (leaf) {
+      if (leaf->count > 0 && leaf->keys[leaf->count - 1] <= high) {
+        result += leaf->count - position;
+      } else {
+        return result + bplus::countNotGreater(leaf->keys, leaf->count, high) - position;
+      }
+      leaf = leaf->next;
+      position = 0;
+    }
+    return result;
+  }
+
+  void deleteNode(int key) {
+    if (!root || !erase(root, levels, key)) {
+      return;
+    }
+    count--;
+    if (levels > 0 && asInner(root)->count == 0) {
+      Inner* top = asInner(root);
+      root = top->children[0];
+      inners.destroy(top);
+      levels--;
+    } else if (levels == 0 && count == 0) {
+      clear();
+    }
+  }
+
+  // Drops every node in O(number of slabs)
+  void clear() {
+    root = nullptr;
+    levels = 0;
+    count = 0;
+    leaves.clear();
+    inners.clear();
+  }
+
+  size_t size() const {
+    return count;
+  }
+
+  // Number of node levels, leaves included (0 for an empty tree)
+  size_t height() const {
+    return root ? levels + 1 : 0;
+  }
+
+  size_t bytesReserved() const {
+    return leaves.bytesReserved() + inners.bytesReserved();
+  }
+
+  // Prints one line per level, each node as [keys]
+  void printTree() const {
+    if (!root) {
+      std::cout << "Puste drzewo\n";
+      return;
+    }
+    std::vector<const void*> current = {root};
+    for (size_t level = levels + 1; level-- > 0;) {
+      std::vector<const void*> below;
+      for (const void* node : current) {
+        printNode(node, level);
+        if (level > 0) {
+          const Inner* inner = asInner(node);
+          below.insert(below.end(), inner->children, inner->children + inner->count + 1);
+        }
+      }
+      std::cout << "\n";
+      current = std::move(below);
+    }
+  }
+};
+
+#endif  // BPLUS_TREE_H
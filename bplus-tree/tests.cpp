@@ -0,0 +1,174 @@
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <iostream>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include "BPlusTree.h"
+
+void testBasic() {
+  std::cout << "Testing BPlusTree basic operations... ";
+  BPlusTree<> tree;
+  bool passed = true;
+
+  try {
+    assert(tree.size() == 0);
+    assert(tree.height() == 0);
+    assert(!tree.contains(1));
+    assert(!tree.lowerBound(1));
+
+    tree.insert(50);
+    tree.insert(20);
+    tree.insert(80);
+    tree.insert(20);
+
+    assert(tree.size() == 3);
+    assert(tree.contains(20));
+    assert(!tree.contains(30));
+    assert(*tree.lowerBound(21) == 50);
+    assert(!tree.lowerBound(81));
+
+    tree.deleteNode(20);
+    tree.deleteNode(20);
+    assert(tree.size() == 2);
+    assert(!tree.contains(20));
+  } catch (...) {
+    passed = false;
+  }
+  std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+void testExtremeKeys() {
+  std::cout << "Testing BPlusTree with INT_MIN and INT_MAX keys... ";
+  BPlusTree<2> tree;
+  bool passed = true;
+
+  try {
+    for (int i = 0; i < 1000; i++) {
+      tree.insert(i);
+    }
+    tree.insert(INT_MAX);
+    tree.insert(INT_MIN);
+
+    assert(tree.contains(INT_MAX));
+    assert(tree.contains(INT_MIN));
+    assert(*tree.lowerBound(1000) == INT_MAX);
+    assert(tree.countInRange(INT_MIN, INT_MAX) == 1002);
+    assert(tree.countInRange(999, INT_MAX) == 2);
+
+    tree.deleteNode(INT_MAX);
+    assert(!tree.contains(INT_MAX));
+    assert(!tree.lowerBound(1000));
+  } catch (...) {
+    passed = false;
+  }
+  std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+void testRangeScan() {
+  std::cout << "Testing BPlusTree range scans across leaves... ";
+  BPlusTree<2> tree;
+  bool passed = true;
+
+  try {
+    for (int i = 0; i < 5000; i++) {
+      tree.insert(i * 2);
+    }
+
+    std::vector<int> visited;
+    tree.forEachInRange(101, 2001, [&](int value) { visited.push_back(value); });
+    assert(visited.size() == 950);
+    assert(visited.front() == 102);
+    assert(visited.back() == 2000);
+    assert(std::is_sorted(visited.begin(), visited.end()));
+    assert(tree.countInRange(101, 2001) == 950);
+    assert(tree.countInRange(2001, 101) == 0);
+  } catch (...) {
+    passed = false;
+  }
+  std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+void testBulkLoad() {
+  std::cout << "Testing BPlusTree bulk load... ";
+  bool passed = true;
+
+  try {
+    std::vector<int> keys;
+    for (int i = 0; i < 100000; i++) {
+      keys.push_back(i * 3);
+    }
+    BPlusTree<> tree = BPlusTree<>::fromSorted(keys.begin(), keys.end());
+    assert(tree.size() == keys.size());
+    assert(tree.height() > 1);
+    for (int i = 0; i < 300000; i += 7) {
+      assert(tree.contains(i) == (i % 3 == 0));
+    }
+
+    // A bulk-loaded tree must accept updates like any other
+    tree.insert(1);
+    tree.deleteNode(0);
+    assert(*tree.lowerBound(0) == 1);
+  } catch (...) {
+    passed = false;
+  }
+
+  try {
+    std::vector<int> unsorted = {1, 3, 2};
+    BPlusTree<>::fromSorted(unsorted.begin(), unsorted.end());
+    passed = false;
+  } catch (const std::invalid_argument&) {
+  }
+  std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+void testRandomAgainstStdSet() {
+  std::cout << "Testing BPlusTree against std::set with random inserts and deletes... ";
+  BPlusTree<2> tree;
+  std::set<int> reference;
+  std::mt19937 rng(42);
+  bool passed = true;
+
+  try {
+    for (int step = 0; step < 200000; step++) {
+      int key = static_cast<int>(rng() % 20000);
+      if (rng() % 2) {
+        tree.insert(key);
+        reference.insert(key);
+      } else {
+        tree.deleteNode(key);
+        reference.erase(key);
+      }
+      assert(tree.size() == reference.size());
+    }
+
+    std::vector<int> keys;
+    tree.forEachInRange(INT_MIN, INT_MAX, [&](int value) { keys.push_back(value); });
+    assert(keys == std::vector<int>(reference.begin(), reference.end()));
+
+    // Deleting everything merges the tree back down to nothing
+    for (int key : keys) {
+      tree.deleteNode(key);
+    }
+    assert(tree.size() == 0);
+    assert(tree.height() == 0);
+  } catch (...) {
+    passed = false;
+  }
+  std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+int main() {
+  std::cout << "\n=== Testing B+tree ===\n";
+  testBasic();
+  testExtremeKeys();
+  testRangeScan();
+  testBulkLoad();
+  testRandomAgainstStdSet();
+
+  std::cout << "\nAll tests completed.\n";
+  return 0;
+}
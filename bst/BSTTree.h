@@ -0,0 +1,236 @@
+#ifndef BST_TREE_H
+#define BST_TREE_H
+
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "NodePool.h"
+#include "StaticIndex.h"
+#include "TreeIterator.h"
+
+struct BSTNode {
+  int value;
+  BSTNode* left;
+  BSTNode* right;
+  BSTNode* parent;  // For iteration; the root's is nullptr
+
+  BSTNode(int val)
+      : value(val), left(nullptr), right(nullptr), parent(nullptr) {
+  }
+};
+
+// Nodes are allocated from the tree's NodePool and released together with it. Nothing recurses,
+// so a degenerate tree (e.g. from sorted insertions) costs time but cannot exhaust the stack.
+class BSTTree {
+  BSTNode* root;
+  NodePool<BSTNode> pool;
+
+ private:
+  // Puts `replacement` (possibly nullptr) where `node` hangs under its parent
+  void transplant(BSTNode* node, BSTNode* replacement) {
+    if (!node->parent) {
+      root = replacement;
+    } else if (node == node->parent->left) {
+      node->parent->left = replacement;
+    } else {
+      node->parent->right = replacement;
+    }
+    if (replacement) {
+      replacement->parent = node->parent;
+    }
+  }
+
+ public:
+  BSTTree()
+      : root(nullptr) {
+  }
+
+  BSTTree(const BSTTree&) = delete;
+  BSTTree& operator=(const BSTTree&) = delete;
+
+  BSTTree(BSTTree&& other) noexcept
+      : root(std::exchange(other.root, nullptr)),
+        pool(std::move(other.pool)) {
+  }
+
+  BSTTree& operator=(BSTTree&& other) noexcept {
+    root = std::exchange(other.root, nullptr);
+    pool = std::move(other.pool);
+    return *this;
+  }
+
+  void insert(int value) {
+    BSTNode* parent = nullptr;
+    BSTNode** link = &root;
+    while (*link) {
+      parent = *link;
+      if (value < parent->value) {
+        link = &parent->left;
+      } else if (value > parent->value) {
+        link = &parent->right;
+      } else {
+        return;
+      }
+    }
+    *link = pool.create(value);
+    (*link)->parent = parent;
+  }
+
+  bool contains(int value) const {
+    const BSTNode* node = root;
+    while (node && node->value != value) {
+      node = value < node->value ? node->left : node->right;
+    }
+    return node != nullptr;
+  }
+
+  // Relinks nodes instead of copying keys, so only iterators to the deleted key are invalidated
+  void deleteNode(int value) {
+    BSTNode* node = root;
+    while (node && node->value != value) {
+      node = value < node->value ? node->left : node->right;
+    }
+    if (!node) {
+      return;
+    }
+
+    if (!node->left) {
+      transplant(node, node->right);
+    } else if (!node->right) {
+      transplant(node, node->left);
+    } else {
+      // The successor has no left child, so it can take the node's place
+      BSTNode* successor = node->right;
+      while (successor->left) {
+        successor = successor->left;
+      }
+      if (successor->parent != node) {
+        transplant(successor, successor->right);
+        successor->right = node->right;
+        successor->right->parent = successor;
+      }
+      transplant(node, successor);
+      successor->left = node->left;
+      successor->left->parent = successor;
+    }
+    pool.destroy(node);
+  }
+
+  using const_iterator = TreeIterator<BSTNode>;
+
+  const_iterator begin() const {
+    return const_iterator(leftmost(root), &root);
+  }
+
+  const_iterator end() const {
+    return const_iterator(nullptr, &root);
+  }
+
+  // First key not less than `value`
+  const_iterator lowerBound(int value) const {
+    return const_iterator(lowerBoundNode(root, value), &root);
+  }
+
+  // First key greater than `value`
+  const_iterator upperBound(int value) const {
+    return const_iterator(lowerBoundNode(root, value, true), &root);
+  }
+
+  // Calls visit(key) for every key in [low, high] in ascending order. O(height + k), no allocation.
+  template <typename Visit>
+  void forEachInRange(int low, int high, Visit&& visit) const {
+    forEachNodeInRange(root, low, high, visit);
+  }
+
+  // Drops every node in O(number of slabs)
+  void clear() {
+    root = nullptr;
+    pool.clear();
+  }
+
+  size_t size() const {
+    return pool.size();
+  }
+
+  size_t bytesReserved() const {
+    return pool.bytesReserved();
+  }
+
+  // O(n), without recursion or a stack
+  int height() const {
+    return treeHeight(root);
+  }
+
+  // Keys in ascending order
+  std::vector<int> toSortedVector() const {
+    return collectInorder(root, size());
+  }
+
+  // Read-only snapshot of the current keys in a cache-friendly array layout. Later changes to the
+  // tree do not show up in the snapshot.
+  StaticIndex freeze(StaticIndex::Layout layout = StaticIndex::Layout::Eytzinger) const {
+    return StaticIndex(toSortedVector(), layout);
+  }
+
+  void printTree() const {
+    if (!root) {
+      std::cout << "Puste drzewo\n";
+      return;
+    }
+
+    std::queue<const BSTNode*> nodes;
+    nodes.push(root);
+    std::vector<std::vector<std::string>> levels;
+
+    while (!nodes.empty()) {
+      size_t size = nodes.size();
+      std::vector<std::string> level;
+
+      for (size_t i = 0; i < size; ++i) {
+        const BSTNode* current = nodes.front();
+        nodes.pop();
+
+        if (current) {
+          level.push_back(std::to_string(current->value));
+          nodes.push(current->left);
+          nodes.push(current->right);
+        } else {
+          level.push_back(" ");
+        }
+      }
+
+      bool hasValidNodes = false;
+      for (const auto& val : level) {
+        if (val != " ") {
+          hasValidNodes = true;
+          break;
+        }
+      }
+      if (hasValidNodes) {
+        levels.push_back(level);
+      }
+    }
+
+    size_t nodeWidth = 4;
+    size_t spacing = 2;
+
+    for (size_t i = 0; i < levels.size(); ++i) {
+      size_t padding = (1 << (levels.size() - i - 1)) * (nodeWidth / 2);
+
+      std::cout << std::string(padding, ' ');
+
+      for (const auto& value : levels[i]) {
+        std::cout << std::setw(nodeWidth) << value;
+        std::cout << std::string(spacing, ' ');
+      }
+      std::cout << '\n';
+    }
+  }
+};
+
+#endif  // BST_TREE_H
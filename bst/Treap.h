@@ -0,0 +1,235 @@
+#ifndef TREAP_H
+#define TREAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "NodePool.h"
+#include "StaticIndex.h"
+#include "TreeIterator.h"
+#include "TreePrinter.h"
+
+struct TreapNode {
+  int value;
+  uint32_t priority;
+  TreapNode* left;
+  TreapNode* right;
+  TreapNode* parent;  // For iteration; the root's is nullptr
+
+  TreapNode(int val, uint32_t prio)
+      : value(val), priority(prio), left(nullptr), right(nullptr), parent(nullptr) {
+  }
+};
+
+// Binary search tree that is also a max-heap on random priorities, so its shape is that of a BST
+// built from the keys in random order whatever order they really arrive in: expected depth
+// O(log n) for sorted, reversed or any other input. insert splits the subtree where the new node
+// belongs, deleteNode merges the removed node's children; both are loops, nothing recurses.
+//
+// Priorities come from a splitmix64 sequence seeded per tree. The default seed is drawn from
+// std::random_device, so an adversary cannot choose keys that line up with the priorities; pass a
+// fixed seed for reproducible shapes.
+class Treap {
+  TreapNode* root;
+  NodePool<TreapNode> pool;
+  uint64_t state;
+
+ private:
+  uint32_t nextPriority() {
+    uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return static_cast<uint32_t>((z ^ (z >> 31)) >> 32);
+  }
+
+  // Splits `node`'s subtree into keys below `value` (hung at *left) and above it (at *right); the
+  // tops of both halves get `parent`. `value` itself must not be in the subtree.
+  static void split(TreapNode* node, int value, TreapNode* parent, TreapNode** left, TreapNode** right) {
+    TreapNode* leftParent = parent;
+    TreapNode* rightParent = parent;
+    while (node) {
+      if (node->value < value) {
+        *left = node;
+        node->parent = leftParent;
+        leftParent = node;
+        left = &node->right;
+        node = node->right;
+      } else {
+        *right = node;
+        node->parent = rightParent;
+        rightParent = node;
+        right = &node->left;
+        node = node->left;
+      }
+    }
+    *left = nullptr;
+    *right = nullptr;
+  }
+
+  // Joins two subtrees where every key in `left` is below every key in `right` and hangs the result
+  // at *link under `parent`
+  static void merge(TreapNode* left, TreapNode* right, TreapNode* parent, TreapNode** link) {
+    while (left && right) {
+      if (left->priority > right->priority) {
+        *link = left;
+        left->parent = parent;
+        parent = left;
+        link = &left->right;
+        left = left->right;
+      } else {
+        *link = right;
+        right->parent = parent;
+        parent = right;
+        link = &right->left;
+        right = right->left;
+      }
+    }
+    *link = left ? left : right;
+    if (*link) {
+      (*link)->parent = parent;
+    }
+  }
+
+  const TreapNode* findNode(int value) const {
+    const TreapNode* node = root;
+    while (node && node->value != value) {
+      node = value < node->value ? node->left : node->right;
+    }
+    return node;
+  }
+
+ public:
+  explicit Treap(uint64_t seed = std::random_device{}())
+      : root(nullptr), state(seed) {
+  }
+
+  Treap(const Treap&) = delete;
+  Treap& operator=(const Treap&) = delete;
+
+  Treap(Treap&& other) noexcept
+      : root(std::exchange(other.root, nullptr)),
+        pool(std::move(other.pool)),
+        state(other.state) {
+  }
+
+  Treap& operator=(Treap&& other) noexcept {
+    root = std::exchange(other.root, nullptr);
+    pool = std::move(other.pool);
+    state = other.state;
+    return *this;
+  }
+
+  // Returns false if `value` was already present
+  bool insert(int value) {
+    if (findNode(value)) {
+      return false;
+    }
+    uint32_t priority = nextPriority();
+
+    // Walk down while the nodes outrank the new one, then split the rest of the path around it
+    TreapNode* parent = nullptr;
+    TreapNode** link = &root;
+    while (*link && (*link)->priority >= priority) {
+      parent = *link;
+      link = value < parent->value ? &parent->left : &parent->right;
+    }
+    TreapNode* node = pool.create(value, priority);
+    split(*link, value, node, &node->left, &node->right);
+    node->parent = parent;
+    *link = node;
+    return true;
+  }
+
+  bool contains(int value) const {
+    return findNode(value) != nullptr;
+  }
+
+  // Returns false if `value` was not present
+  bool deleteNode(int value) {
+    TreapNode* node = root;
+    while (node && node->value != value) {
+      node = value < node->value ? node->left : node->right;
+    }
+    if (!node) {
+      return false;
+    }
+    TreapNode* parent = node->parent;
+    TreapNode** link = !parent ? &root : node == parent->left ? &parent->left : &parent->right;
+    merge(node->left, node->right, parent, link);
+    pool.destroy(node);
+    return true;
+  }
+
+  using const_iterator = TreeIterator<TreapNode>;
+
+  const_iterator begin() const {
+    return const_iterator(leftmost(root), &root);
+  }
+
+  const_iterator end() const {
+    return const_iterator(nullptr, &root);
+  }
+
+  // First key not less than `value`
+  const_iterator lowerBound(int value) const {
+    return const_iterator(lowerBoundNode(root, value), &root);
+  }
+
+  // First key greater than `value`
+  const_iterator upperBound(int value) const {
+    return const_iterator(lowerBoundNode(root, value, true), &root);
+  }
+
+  // Calls visit(key) for every key in [low, high] in ascending order. O(height + k), no allocation.
+  template <typename Visit>
+  void forEachInRange(int low, int high, Visit&& visit) const {
+    forEachNodeInRange(root, low, high, visit);
+  }
+
+  // Drops every node in O(number of slabs)
+  void clear() {
+    root = nullptr;
+    pool.clear();
+  }
+
+  size_t size() const {
+    return pool.size();
+  }
+
+  size_t bytesReserved() const {
+    return pool.bytesReserved();
+  }
+
+  // O(n), without recursion or a stack
+  int height() const {
+    return treeHeight(root);
+  }
+
+  // Keys in ascending order
+  std::vector<int> toSortedVector() const {
+    return collectInorder(root, size());
+  }
+
+  // Read-only snapshot of the current keys in a cache-friendly array layout. Later changes to the
+  // tree do not show up in the snapshot.
+  StaticIndex freeze(StaticIndex::Layout layout = StaticIndex::Layout::Eytzinger) const {
+    return StaticIndex(toSortedVector(), layout);
+  }
+
+  void printTree() const {
+    if (!root) {
+      std::cout << "Puste drzewo\n";
+      return;
+    }
+    std::vector<std::vector<std::string>> result = treeToMatrix(root);
+
+    print2DArray(result);
+  }
+};
+
+#endif  // TREAP_H
@@ -0,0 +1,137 @@
+#ifndef EPOCH_RECLAMATION_H
+#define EPOCH_RECLAMATION_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Epoch-based reclamation for concurrent structures whose readers take no locks.
+//
+// A reader cannot tell when a node it is looking at gets unlinked, so an unlinked node may only
+// be freed once every thread that could still hold a pointer to it has finished. Each operation
+// runs inside a Guard, which announces the global epoch the thread entered in. retire() files a
+// node under the current epoch. The epoch only advances when every active guard has caught up
+// with it, so once it has moved on twice past a node's epoch, no guard can still see the node.
+//
+//   EpochDomain epochs;
+//   {
+//     EpochDomain::Guard guard(epochs);
+//     ... read shared nodes, unlink some ...
+//     epochs.retire(node);
+//   }
+
+class EpochDomain {
+  static constexpr size_t SLOTS = 128;               // Guards that can be active at once
+  static constexpr uint64_t FREE = UINT64_MAX;       // Slot not held by any guard
+  static constexpr size_t ADVANCE_INTERVAL = 64;     // Retirements between attempts to advance
+
+  struct Retired {
+    void* node;
+    void (*destroy)(void*);
+  };
+
+  struct alignas(64) Slot {
+    std::atomic<uint64_t> epoch{FREE};
+  };
+
+  std::atomic<uint64_t> globalEpoch{0};
+  Slot slots[SLOTS];
+
+  std::mutex limboLock;
+  std::vector<Retired> limbo[3];  // Retired nodes by epoch % 3
+  size_t retiredSinceAdvance = 0;
+
+  static void release(std::vector<Retired>& bag) {
+    for (const Retired& retired : bag) {
+      retired.destroy(retired.node);
+    }
+    bag.clear();
+  }
+
+  // Moves the epoch from e to e + 1 if no active guard is still in an older epoch, then frees the
+  // bag of e - 2, whose nodes no guard can reach any more. Called with limboLock held.
+  void tryAdvance() {
+    uint64_t epoch = globalEpoch.load();
+    for (const Slot& slot : slots) {
+      uint64_t announced = slot.epoch.load();
+      if (announced != FREE && announced != epoch) {
+        return;
+      }
+    }
+    globalEpoch.store(epoch + 1);
+    release(limbo[(epoch + 1) % 3]);
+    retiredSinceAdvance = 0;
+  }
+
+ public:
+  class Guard {
+    EpochDomain& domain;
+    size_t slot;
+
+   public:
+    explicit Guard(EpochDomain& domain)
+        : domain(domain) {
+      // Threads start probing at different slots so they rarely compete for one
+      static thread_local size_t hint = std::hash<std::thread::id>{}(std::this_thread::get_id()) % SLOTS;
+      for (size_t attempt = 0;; attempt++) {
+        size_t candidate = (hint + attempt) % SLOTS;
+        uint64_t expected = FREE;
+        if (domain.slots[candidate].epoch.load(std::memory_order_relaxed) == FREE &&
+            domain.slots[candidate].epoch.compare_exchange_strong(expected, domain.globalEpoch.load())) {
+          slot = candidate;
+          hint = candidate;
+          break;
+        }
+        if (attempt % SLOTS == SLOTS - 1) {
+          std::this_thread::yield();  // Every slot is taken; wait for a guard to finish
+        }
+      }
+    }
+
+    Guard(const Guard&) = delete;
+    Guard& operator=(const Guard&) = delete;
+
+    ~Guard() {
+      domain.slots[slot].epoch.store(FREE, std::memory_order_release);
+    }
+  };
+
+  EpochDomain() = default;
+  EpochDomain(const EpochDomain&) = delete;
+  EpochDomain& operator=(const EpochDomain&) = delete;
+
+  // No guard may be active any more, so everything still waiting is freed
+  ~EpochDomain() {
+    for (auto& bag : limbo) {
+      release(bag);
+    }
+  }
+
+  // Frees `node` with delete once no guard can still reach it. The node must already be
+  // unreachable for operations that start from now on.
+  template <typename T>
+  void retire(T* node) {
+    retire(node, [](void* p) { delete static_cast<T*>(p); });
+  }
+
+  // Same, for nodes that were not allocated with plain new: destroy(node) frees it
+  void retire(void* node, void (*destroy)(void*)) {
+    std::lock_guard<std::mutex> lock(limboLock);
+    limbo[globalEpoch.load() % 3].push_back({node, destroy});
+    if (++retiredSinceAdvance >= ADVANCE_INTERVAL) {
+      tryAdvance();
+    }
+  }
+
+  // Nodes retired but not yet freed
+  size_t pending() {
+    std::lock_guard<std::mutex> lock(limboLock);
+    return limbo[0].size() + limbo[1].size() + limbo[2].size();
+  }
+};
+
+#endif  // EPOCH_RECLAMATION_H
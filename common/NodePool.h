@@ -0,0 +1,262 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Pool allocators for tree nodes.
+//
+// Nodes are carved out of large contiguous blocks instead of being separate heap allocations, so
+// nodes created together sit next to each other in memory. A destroyed node goes on an intrusive
+// free list and is reused by the next create(). clear() drops whole blocks at once, which makes
+// tearing down a tree O(number of blocks) instead of a recursive walk over every node.
+//
+// clear() does not run node destructors. IndexedNodePool accepts only trivially destructible node
+// types; NodePool also takes others, whose owner must destroy() every live node before clear().
+
+// Pointer-based pool: nodes live in slabs that never move, so create() returns a plain T* that
+// stays valid until destroy() or clear().
+template <typename T>
+class NodePool {
+
+  union Slot {
+    Slot* next;
+    alignas(T) unsigned char storage[sizeof(T)];
+  };
+
+  static constexpr size_t FIRST_SLAB = 64;
+  static constexpr size_t MAX_SLAB = size_t(1) << 16;  // Slots per slab once the pool has grown
+
+  std::vector<std::unique_ptr<Slot[]>> slabs;
+  size_t slabCapacity = 0;  // Slots in the newest slab
+  size_t slabUsed = 0;      // Slots handed out from the newest slab
+  size_t reserved = 0;      // Slots in all slabs
+  size_t live = 0;
+  Slot* freeList = nullptr;
+  Slot* freeTail = nullptr;  // Last slot of freeList, so adopt() can splice without walking it
+
+  Slot* allocateSlot() {
+    if (freeList) {
+      Slot* slot = freeList;
+      freeList = slot->next;
+      if (!freeList) {
+        freeTail = nullptr;
+      }
+      return slot;
+    }
+    if (slabUsed == slabCapacity) {
+      // Slabs double in size up to MAX_SLAB, so small trees stay small and large ones need few slabs
+      slabCapacity = std::max(FIRST_SLAB, std::min(slabCapacity * 2, MAX_SLAB));
+      slabs.emplace_back(new Slot[slabCapacity]);
+      reserved += slabCapacity;
+      slabUsed = 0;
+    }
+    return &slabs.back()[slabUsed++];
+  }
+
+ public:
+  NodePool() = default;
+  NodePool(const NodePool&) = delete;
+  NodePool& operator=(const NodePool&) = delete;
+
+  NodePool(NodePool&& other) noexcept
+      : slabs(std::move(other.slabs)),
+        slabCapacity(std::exchange(other.slabCapacity, 0)),
+        slabUsed(std::exchange(other.slabUsed, 0)),
+        reserved(std::exchange(other.reserved, 0)),
+        live(std::exchange(other.live, 0)),
+        freeList(std::exchange(other.freeList, nullptr)),
+        freeTail(std::exchange(other.freeTail, nullptr)) {
+  }
+
+  NodePool& operator=(NodePool&& other) noexcept {
+    if (this != &other) {
+      slabs = std::move(other.slabs);
+      slabCapacity = std::exchange(other.slabCapacity, 0);
+      slabUsed = std::exchange(other.slabUsed, 0);
+      reserved = std::exchange(other.reserved, 0);
+      live = std::exchange(other.live, 0);
+      freeList = std::exchange(other.freeList, nullptr);
+      freeTail = std::exchange(other.freeTail, nullptr);
+    }
+    return *this;
+  }
+
+  template <typename... Args>
+  T* create(Args&&... args) {
+    Slot* slot = allocateSlot();
+    live++;
+    return new (slot->storage) T(std::forward<Args>(args)...);
+  }
+
+  void destroy(T* node) {
+    node->~T();
+    Slot* slot = reinterpret_cast<Slot*>(node);
+    slot->next = freeList;
+    if (!freeList) {
+      freeTail = slot;
+    }
+    freeList = slot;
+    live--;
+  }
+
+  // Takes over all of `other`'s slabs, so nodes created by either pool are now owned (and may be
+  // destroyed) by this one; `other` is left empty. O(number of slabs): other's free list is spliced
+  // in front of ours. The unused tail of other's newest slab is not reclaimed until clear().
+  void adopt(NodePool&& other) {
+    if (this == &other) {
+      return;
+    }
+    if (other.freeList) {
+      other.freeTail->next = freeList;
+      if (!freeList) {
+        freeTail = other.freeTail;
+      }
+      freeList = other.freeList;
+    }
+    // Other's slabs go in front so the newest slab, the one create() carves from, stays ours
+    slabs.insert(slabs.begin(), std::make_move_iterator(other.slabs.begin()),
+                 std::make_move_iterator(other.slabs.end()));
+    reserved += other.reserved;
+    live += other.live;
+    other.slabs.clear();
+    other.slabCapacity = other.slabUsed = other.reserved = other.live = 0;
+    other.freeList = other.freeTail = nullptr;
+  }
+
+  // Releases every node at once without destroying them. Pointers handed out earlier become
+  // dangling.
+  void clear() {
+    slabs.clear();
+    slabCapacity = slabUsed = reserved = live = 0;
+    freeList = freeTail = nullptr;
+  }
+
+  size_t size() const {
+    return live;
+  }
+
+  size_t bytesReserved() const {
+    return reserved * sizeof(Slot);
+  }
+};
+
+// Index-based pool: nodes are addressed by 32-bit handles instead of 64-bit pointers, so a node
+// with two children shrinks by 8 bytes. All nodes sit in one contiguous array, so a handle turns
+// into an address with a single multiply-add. The array doubles when full, which moves the nodes:
+// references obtained through operator[] are invalidated by create(), handles are not.
+template <typename T>
+class IndexedNodePool {
+  static_assert(std::is_trivially_copyable<T>::value, "IndexedNodePool relocates nodes with memcpy");
+
+ public:
+  using Index = uint32_t;
+  static constexpr Index NONE = UINT32_MAX;
+
+ private:
+  static constexpr size_t FIRST_CAPACITY = 64;
+
+  union Slot {
+    Index next;
+    alignas(T) unsigned char storage[sizeof(T)];
+  };
+
+  std::unique_ptr<Slot[]> slots;
+  size_t capacity = 0;
+  Index end = 0;  // First handle never handed out
+  size_t live = 0;
+  Index freeList = NONE;
+
+  void grow() {
+    size_t newCapacity = capacity ? std::min(capacity * 2, size_t(NONE)) : FIRST_CAPACITY;
+    if (newCapacity == capacity) {
+      throw std::bad_alloc();  // Every 32-bit handle is in use
+    }
+    std::unique_ptr<Slot[]> grown(new Slot[newCapacity]);
+    if (end) {
+      std::memcpy(grown.get(), slots.get(), end * sizeof(Slot));
+    }
+    slots = std::move(grown);
+    capacity = newCapacity;
+  }
+
+ public:
+  IndexedNodePool() = default;
+  IndexedNodePool(const IndexedNodePool&) = delete;
+  IndexedNodePool& operator=(const IndexedNodePool&) = delete;
+
+  IndexedNodePool(IndexedNodePool&& other) noexcept
+      : slots(std::move(other.slots)),
+        capacity(std::exchange(other.capacity, 0)),
+        end(std::exchange(other.end, 0)),
+        live(std::exchange(other.live, 0)),
+        freeList(std::exchange(other.freeList, NONE)) {
+  }
+
+  IndexedNodePool& operator=(IndexedNodePool&& other) noexcept {
+    if (this != &other) {
+      slots = std::move(other.slots);
+      capacity = std::exchange(other.capacity, 0);
+      end = std::exchange(other.end, 0);
+      live = std::exchange(other.live, 0);
+      freeList = std::exchange(other.freeList, NONE);
+    }
+    return *this;
+  }
+
+  template <typename... Args>
+  Index create(Args&&... args) {
+    Index index;
+    if (freeList != NONE) {
+      index = freeList;
+      freeList = slots[index].next;
+    } else {
+      if (end == capacity) {
+        grow();
+      }
+      index = end++;
+    }
+    new (slots[index].storage) T(std::forward<Args>(args)...);
+    live++;
+    return index;
+  }
+
+  void destroy(Index index) {
+    slots[index].next = freeList;
+    freeList = index;
+    live--;
+  }
+
+  T& operator[](Index index) {
+    return *std::launder(reinterpret_cast<T*>(slots[index].storage));
+  }
+
+  const T& operator[](Index index) const {
+    return *std::launder(reinterpret_cast<const T*>(slots[index].storage));
+  }
+
+  void clear() {
+    slots.reset();
+    capacity = 0;
+    end = 0;
+    live = 0;
+    freeList = NONE;
+  }
+
+  size_t size() const {
+    return live;
+  }
+
+  size_t bytesReserved() const {
+    return capacity * sizeof(Slot);
+  }
+};
+
+#endif  // NODE_POOL_H
@@ -0,0 +1,268 @@
+#ifndef STATIC_INDEX_H
+#define STATIC_INDEX_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+// Immutable search index over a sorted key set, stored as an implicit tree in one array.
+//
+//   Eytzinger    BFS order (children of k at 2k and 2k + 1). The search is branch-free, and the 16
+//                great-great-grandchildren of a node share one cache line, which is prefetched four
+//                levels ahead; batch lookups interleave 16 searches to overlap their misses.
+//   VanEmdeBoas  Recursive layout: the top half of the tree's levels first, then each bottom
+//                subtree, each laid out the same way. Every block of consecutive levels sits in a
+//                contiguous range, so a search touches O(log_B n) cache lines for any line size B
+//                without tuning. The tree is padded to a complete one.
+//
+// Built by AVLTree/BSTTree/SplayTree::freeze() or directly from a sorted vector.
+
+class StaticIndex {
+ public:
+  enum class Layout { Eytzinger, VanEmdeBoas };
+
+ private:
+  static constexpr size_t LINE_INTS = 64 / sizeof(int);  // Keys per cache line
+  static constexpr size_t BATCH = 16;                    // Searches interleaved by the batch lookup
+
+  struct AlignedDelete {
+    void operator()(int* keys) const {
+      ::operator delete[](keys, std::align_val_t(64));
+    }
+  };
+
+  Layout layout;
+  size_t count;
+  size_t slots = 0;
+  std::unique_ptr<int[], AlignedDelete> keys;  // Cache-line aligned; Eytzinger uses keys[1..count]
+
+  // van Emde Boas: tree height and, per depth d > 0, the split where depth d starts a bottom tree:
+  // size of the top tree (also the mask selecting the bottom tree), size of each bottom tree, and
+  // the depth of the top tree's root.
+  int height = 0;
+  std::vector<uint32_t> topSize;
+  std::vector<uint32_t> bottomSize;
+  std::vector<int> topDepth;
+
+  void allocate(size_t slotCount) {
+    slots = slotCount;
+    keys.reset(static_cast<int*>(::operator new[](slots * sizeof(int), std::align_val_t(64))));
+  }
+
+  size_t fillEytzinger(const std::vector<int>& sorted, size_t i, size_t k) {
+    if (k <= count) {
+      i = fillEytzinger(sorted, i, 2 * k);
+      keys[k] = sorted[i++];
+      i = fillEytzinger(sorted, i, 2 * k + 1);
+    }
+    return i;
+  }
+
+  void splitLevels(int firstDepth, int levels) {
+    if (levels <= 1) {
+      return;
+    }
+    int top = levels / 2;
+    int bottom = levels - top;
+    int boundary = firstDepth + top;
+    topSize[boundary] = (uint32_t(1) << top) - 1;
+    bottomSize[boundary] = (uint32_t(1) << bottom) - 1;
+    topDepth[boundary] = firstDepth;
+    splitLevels(firstDepth, top);
+    splitLevels(boundary, bottom);
+  }
+
+  // Writes the subtree rooted at BFS index `node` (`levels` deep) starting at keys[next]
+  void fillVanEmdeBoas(const std::vector<int>& complete, uint64_t node, int levels, size_t& next) {
+    if (levels == 1) {
+      keys[next++] = complete[node];
+      return;
+    }
+    int top = levels / 2;
+    int bottom = levels - top;
+    fillVanEmdeBoas(complete, node, top, next);
+    for (uint64_t child = 0; child < (uint64_t(1) << top); child++) {
+      fillVanEmdeBoas(complete, (node << top) + child, bottom, next);
+    }
+  }
+
+  // In-order position of BFS node `node` in a complete tree of `height` levels
+  size_t inorderRank(uint64_t node, int depth) const {
+    uint64_t offset = node - (uint64_t(1) << depth);
+    return ((2 * offset + 1) << (height - 1 - depth)) - 1;
+  }
+
+  std::optional<int> lowerBoundEytzinger(int key) const {
+    size_t k = 1;
+    while (k <= count) {
+      __builtin_prefetch(reinterpret_cast<const void*>(reinterpret_cast<uintptr_t>(keys.get()) + k * LINE_INTS * sizeof(int)));
+      k = 2 * k + (keys[k] < key);
+    }
+    // The answer is the last node where the search went left: strip the trailing right turns
+    k >>= __builtin_ffsll(~static_cast<long long>(k));
+    if (k == 0) {
+      return std::nullopt;
+    }
+    return keys[k];
+  }
+
+  std::optional<int> lowerBoundVanEmdeBoas(int key) const {
+    if (count == 0) {
+      return std::nullopt;
+    }
+    size_t position[64];
+    uint64_t node = 1;
+    position[0] = 0;
+    for (int depth = 0; depth < height; depth++) {
+      if (depth > 0) {
+        position[depth] = position[topDepth[depth]] + topSize[depth] + (node & topSize[depth]) * bottomSize[depth];
+      }
+      node = 2 * node + (keys[position[depth]] < key);
+    }
+    int turns = __builtin_ffsll(~static_cast<long long>(node));
+    node >>= turns;
+    if (node == 0) {
+      return std::nullopt;
+    }
+    int depth = height - turns;
+    if (inorderRank(node, depth) >= count) {
+      return std::nullopt;  // Padding
+    }
+    return keys[position[depth]];
+  }
+
+ public:
+  // `sorted` must be in non-decreasing order (std::invalid_argument otherwise)
+  explicit StaticIndex(const std::vector<int>& sorted, Layout layout = Layout::Eytzinger)
+      : layout(layout),
+        count(sorted.size()) {
+    if (!std::is_sorted(sorted.begin(), sorted.end())) {
+      throw std::invalid_argument("StaticIndex: keys must be sorted");
+    }
+
+    if (layout == Layout::Eytzinger) {
+      allocate(count + 1);
+      fillEytzinger(sorted, 0, 1);
+      return;
+    }
+
+    while ((size_t(1) << height) - 1 < count) {
+      height++;
+    }
+    size_t treeSlots = (size_t(1) << height) - 1;
+    topSize.assign(height + 1, 0);
+    bottomSize.assign(height + 1, 0);
+    topDepth.assign(height + 1, 0);
+    splitLevels(0, height);
+
+    // Complete tree in BFS order first (padding after the largest key), then reorder it
+    std::vector<int> complete(treeSlots + 1);
+    std::vector<int> padded(sorted);
+    padded.resize(treeSlots, std::numeric_limits<int>::max());
+    size_t next = 0;
+    // In-order walk of the BFS tree assigns the sorted keys
+    std::vector<uint64_t> stack;
+    uint64_t node = 1;
+    while (node <= treeSlots || !stack.empty()) {
+      while (node <= treeSlots) {
+        stack.push_back(node);
+        node *= 2;
+      }
+      node = stack.back();
+      stack.pop_back();
+      complete[node] = padded[next++];
+      node = 2 * node + 1;
+    }
+
+    allocate(treeSlots);
+    next = 0;
+    if (height > 0) {
+      fillVanEmdeBoas(complete, 1, height, next);
+    }
+  }
+
+  // Smallest key that is not less than `key`, if any
+  std::optional<int> lowerBound(int key) const {
+    return layout == Layout::Eytzinger ? lowerBoundEytzinger(key) : lowerBoundVanEmdeBoas(key);
+  }
+
+  // lowerBound for `queryCount` keys at once. With the Eytzinger layout the searches advance in
+  // lockstep, BATCH at a time, so their cache misses overlap instead of queueing up.
+  void lowerBound(const int* queries, size_t queryCount, std::optional<int>* results) const {
+    if (layout != Layout::Eytzinger) {
+      for (size_t i = 0; i < queryCount; i++) {
+        results[i] = lowerBoundVanEmdeBoas(queries[i]);
+      }
+      return;
+    }
+
+    // Every search takes the same number of steps; all but the last stay inside the array
+    int fullLevels = 0;
+    while ((size_t(2) << fullLevels) - 1 <= count) {
+      fullLevels++;
+    }
+
+    for (size_t first = 0; first < queryCount; first += BATCH) {
+      size_t n = std::min(BATCH, queryCount - first);
+      size_t k[BATCH];
+      for (size_t j = 0; j < n; j++) {
+        k[j] = 1;
+      }
+      for (int level = 0; level < fullLevels; level++) {
+        for (size_t j = 0; j < n; j++) {
+          k[j] = 2 * k[j] + (keys[k[j]] < queries[first + j]);
+          __builtin_prefetch(reinterpret_cast<const void*>(reinterpret_cast<uintptr_t>(keys.get()) + k[j] * sizeof(int)));
+        }
+      }
+      for (size_t j = 0; j < n; j++) {
+        if (k[j] <= count) {
+          k[j] = 2 * k[j] + (keys[k[j]] < queries[first + j]);
+        }
+        size_t node = k[j] >> __builtin_ffsll(~static_cast<long long>(k[j]));
+        results[first + j] = node ? std::optional<int>(keys[node]) : std::nullopt;
+      }
+    }
+  }
+
+  bool contains(int key) const {
+    std::optional<int> found = lowerBound(key);
+    return found && *found == key;
+  }
+
+  size_t size() const {
+    return count;
+  }
+
+  size_t bytes() const {
+    return slots * sizeof(int);
+  }
+};
+
+// Keys of a binary search tree in ascending order, without recursion so that degenerate trees
+// cannot overflow the stack. Works with any node type that has `value`, `left` and `right` members.
+template <typename NodeT>
+std::vector<int> collectInorder(const NodeT* root, size_t count = 0) {
+  std::vector<int> keys;
+  keys.reserve(count);
+  std::vector<const NodeT*> stack;
+  const NodeT* node = root;
+  while (node || !stack.empty()) {
+    while (node) {
+      stack.push_back(node);
+      node = node->left;
+    }
+    node = stack.back();
+    stack.pop_back();
+    keys.push_back(node->value);
+    node = node->right;
+  }
+  return keys;
+}
+
+#endif  // STATIC_INDEX_H
@@ -0,0 +1,173 @@
+#ifndef TREE_ITERATOR_H
+#define TREE_ITERATOR_H
+
+#include <cstddef>
+#include <iterator>
+
+// In-order navigation for binary search trees whose nodes have `left`, `right` and `parent`
+// members, plus an int `value` for lowerBoundNode, forEachNodeInRange and TreeIterator. The
+// navigation helpers take const and mutable node pointers alike. Everything here walks the parent
+// pointers, so it needs neither recursion nor a stack: one step costs O(height) at worst, and a
+// scan over k consecutive keys O(height + k).
+
+template <typename NodePtr>
+NodePtr leftmost(NodePtr node) {
+  if (node) {
+    while (node->left) {
+      node = node->left;
+    }
+  }
+  return node;
+}
+
+template <typename NodePtr>
+NodePtr rightmost(NodePtr node) {
+  if (node) {
+    while (node->right) {
+      node = node->right;
+    }
+  }
+  return node;
+}
+
+// Next node in key order, or nullptr after the largest key
+template <typename NodePtr>
+NodePtr successor(NodePtr node) {
+  if (node->right) {
+    return leftmost<NodePtr>(node->right);
+  }
+  NodePtr parent = node->parent;
+  while (parent && node == parent->right) {
+    node = parent;
+    parent = parent->parent;
+  }
+  return parent;
+}
+
+template <typename NodePtr>
+NodePtr predecessor(NodePtr node) {
+  if (node->left) {
+    return rightmost<NodePtr>(node->left);
+  }
+  NodePtr parent = node->parent;
+  while (parent && node == parent->left) {
+    node = parent;
+    parent = parent->parent;
+  }
+  return parent;
+}
+
+// First node whose key is not less than `value` (or greater than it, when `strict` is set)
+template <typename NodeT>
+const NodeT* lowerBoundNode(const NodeT* node, int value, bool strict = false) {
+  const NodeT* result = nullptr;
+  while (node) {
+    if (value < node->value || (!strict && value == node->value)) {
+      result = node;
+      node = node->left;
+    } else {
+      node = node->right;
+    }
+  }
+  return result;
+}
+
+// Calls visit(key) for every key in [low, high] in ascending order
+template <typename NodeT, typename Visit>
+void forEachNodeInRange(const NodeT* root, int low, int high, Visit&& visit) {
+  if (low > high) {
+    return;
+  }
+  for (const NodeT* node = lowerBoundNode(root, low); node && node->value <= high; node = successor(node)) {
+    visit(node->value);
+  }
+}
+
+// Levels on the longest root-to-leaf path, 0 for an empty tree. O(n) time, O(1) space.
+template <typename NodeT>
+int treeHeight(const NodeT* root) {
+  int best = 0;
+  int depth = 1;
+  const NodeT* node = root;
+  const NodeT* previous = nullptr;
+  while (node) {
+    const NodeT* next;
+    if (previous == node->parent) {
+      best = depth > best ? depth : best;
+      next = node->left ? node->left : node->right ? node->right : node->parent;
+    } else if (previous == node->left && node->right) {
+      next = node->right;
+    } else {
+      next = node->parent;
+    }
+    depth += next == node->parent ? -1 : 1;
+    previous = node;
+    node = next;
+  }
+  return best;
+}
+
+// Read-only bidirectional iterator over the keys. It keeps a pointer to the tree's root field, so
+// --end() finds the largest key even after the root has changed.
+template <typename NodeT>
+class TreeIterator {
+  const NodeT* node;
+  const NodeT* const* root;
+
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = int;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const int*;
+  using reference = const int&;
+
+  TreeIterator()
+      : node(nullptr),
+        root(nullptr) {
+  }
+
+  TreeIterator(const NodeT* node, const NodeT* const* root)
+      : node(node),
+        root(root) {
+  }
+
+  reference operator*() const {
+    return node->value;
+  }
+
+  pointer operator->() const {
+    return &node->value;
+  }
+
+  TreeIterator& operator++() {
+    node = successor(node);
+    return *this;
+  }
+
+  TreeIterator operator++(int) {
+    TreeIterator previous = *this;
+    ++*this;
+    return previous;
+  }
+
+  TreeIterator& operator--() {
+    node = node ? predecessor(node) : rightmost(*root);
+    return *this;
+  }
+
+  TreeIterator operator--(int) {
+    TreeIterator previous = *this;
+    --*this;
+    return previous;
+  }
+
+  bool operator==(const TreeIterator& other) const {
+    return node == other.node;
+  }
+
+  bool operator!=(const TreeIterator& other) const {
+    return node != other.node;
+  }
+};
+
+#endif  // TREE_ITERATOR_H
@@ -6,32 +6,23 @@
 #include <string>
 #include <vector>
 
-struct Node {
-  int value;
-  Node* left;
-  Node* right;
-
-  Node(int v)
-      : value(v),
-        left(nullptr),
-        right(nullptr) {
-  }
-};
-
 // Printing tree implemented from https://www.geeksforgeeks.org/print-binary-tree-2-dimensions/
+// Works with any node type that has `value`, `left` and `right` members.
 
-int findHeight(Node* root) {
+template <typename NodeT>
+int findHeight(const NodeT* root) {
   if (!root) {
     return -1;
   }
 
-  int leftHeight = findHeight(root->left);
-  int rightHeight = findHeight(root->right);
+  int leftHeight = findHeight<NodeT>(root->left);
+  int rightHeight = findHeight<NodeT>(root->right);
 
   return std::max(leftHeight, rightHeight) + 1;
 }
 
-void inorder(Node* root, int row, int col, int height,
+template <typename NodeT>
+void inorder(const NodeT* root, int row, int col, int height,
              std::vector<std::vector<std::string>>& ans) {
   if (!root) {
     return;
@@ -40,17 +31,18 @@ void inorder(Node* root, int row, int col, int height,
   int offset = std::pow(2, height - row - 1);
 
   if (root->left) {
-    inorder(root->left, row + 1, col - offset, height, ans);
+    inorder<NodeT>(root->left, row + 1, col - offset, height, ans);
   }
 
   ans[row][col] = std::to_string(root->value);
 
   if (root->right) {
-    inorder(root->right, row + 1, col + offset, height, ans);
+    inorder<NodeT>(root->right, row + 1, col + offset, height, ans);
   }
 }
 
-std::vector<std::vector<std::string>> treeToMatrix(Node* root) {
+template <typename NodeT>
+std::vector<std::vector<std::string>> treeToMatrix(const NodeT* root) {
   int height = findHeight(root);
   int rows = height + 1;
   int cols = std::pow(2, height + 1) - 1;
@@ -60,7 +52,7 @@ std::vector<std::vector<std::string>> treeToMatrix(Node* root) {
   return ans;
 }
 
-void print2DArray(const std::vector<std::vector<std::string>>& arr) {
+inline void print2DArray(const std::vector<std::vector<std::string>>& arr) {
   for (const auto& row : arr) {
     for (const auto& cell : row) {
       if (cell.empty()) {
@@ -73,4 +65,4 @@ void print2DArray(const std::vector<std::vector<std::string>>& arr) {
   }
 }
 
-#endif  // TREE_PRINTER_H
\ No newline at end of file
+#endif  // TREE_PRINTER_H
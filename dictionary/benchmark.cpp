@@ -0,0 +1,284 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "benchmark_utils.h"
+#include "cursor_doubly_linked_list.cpp"
+#include "cursor_doubly_linked_list_vector.cpp"
+#include "cursor_singly_linked_list.cpp"
+#include "cursor_singly_linked_list_vector.cpp"
+#include "cursor_soa_linked_list.cpp"
+#include "doubly_linked_list.cpp"
+#include "singly_linked_list.cpp"
+#include "unrolled_linked_list.cpp"
+
+// Every list in this directory under the same workload: insert `size` distinct random keys, run
+// --lookups contains() calls (half of them for keys that are present) and remove half as many
+// present keys. Times are ns per operation; each list must find exactly the present keys.
+//
+// The global operator new and delete below count every heap allocation, so the output also has
+// the bytes and allocations each list holds per key once the inserts are done, including its
+// spare capacity (the allocator's own headers are not counted). Where perf_event_open is allowed,
+// each phase also reports hardware cache misses per operation; otherwise those columns are empty.
+//
+//   ./benchmark [--sizes 1e2,1e3,1e4,1e5] [--lookups 2000] [--csv data/dictionary_benchmark.csv]
+
+struct AllocationStats {
+  size_t allocations = 0;
+  size_t liveBytes = 0;
+};
+
+AllocationStats allocationStats;
+
+// Each block starts with a header holding its size, so delete knows how many bytes go away. The
+// header is as large as the block's alignment to keep the caller's part aligned.
+void* countedAllocate(size_t bytes, size_t alignment) {
+  size_t header = std::max(alignment, alignof(std::max_align_t));
+  void* block = nullptr;
+  if (posix_memalign(&block, header, header + bytes) != 0) {
+    throw std::bad_alloc();
+  }
+  *static_cast<size_t*>(block) = bytes;
+  allocationStats.allocations++;
+  allocationStats.liveBytes += bytes;
+  return static_cast<char*>(block) + header;
+}
+
+void countedRelease(void* pointer, size_t alignment) noexcept {
+  if (!pointer) return;
+  size_t header = std::max(alignment, alignof(std::max_align_t));
+  void* block = static_cast<char*>(pointer) - header;
+  allocationStats.liveBytes -= *static_cast<size_t*>(block);
+  std::free(block);
+}
+
+void* operator new(size_t bytes) {
+  return countedAllocate(bytes, alignof(std::max_align_t));
+}
+
+void* operator new(size_t bytes, std::align_val_t alignment) {
+  return countedAllocate(bytes, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* pointer) noexcept {
+  countedRelease(pointer, alignof(std::max_align_t));
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+  countedRelease(pointer, alignof(std::max_align_t));
+}
+
+void operator delete(void* pointer, std::align_val_t alignment) noexcept {
+  countedRelease(pointer, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* pointer, size_t, std::align_val_t alignment) noexcept {
+  countedRelease(pointer, static_cast<size_t>(alignment));
+}
+
+// Hardware cache misses of this thread, counted between start() and stop()
+class CacheMissCounter {
+ private:
+  int fd = -1;
+
+ public:
+  CacheMissCounter() {
+#ifdef __linux__
+    perf_event_attr attr{};
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+  }
+
+  CacheMissCounter(const CacheMissCounter&) = delete;
+  CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+
+  ~CacheMissCounter() {
+#ifdef __linux__
+    if (fd >= 0) close(fd);
+#endif
+  }
+
+  bool available() const {
+    return fd >= 0;
+  }
+
+  void start() {
+#ifdef __linux__
+    if (fd < 0) return;
+    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+  }
+
+  uint64_t stop() {
+    uint64_t misses = 0;
+#ifdef __linux__
+    if (fd < 0) return 0;
+    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    if (read(fd, &misses, sizeof(misses)) != sizeof(misses)) misses = 0;
+#endif
+    return misses;
+  }
+};
+
+struct Phase {
+  double ns = 0;
+  double cacheMisses = 0;
+};
+
+struct Result {
+  Phase insert;
+  Phase contains;
+  Phase remove;
+  double bytesPerKey = 0;
+  double allocationsPerKey = 0;
+  bool valid = false;
+};
+
+// Times `operations` operations done by f, per operation
+template <typename F>
+Phase measure(CacheMissCounter& counter, size_t operations, F&& f) {
+  Phase phase;
+  counter.start();
+  phase.ns = timeNs(f) / operations;
+  phase.cacheMisses = static_cast<double>(counter.stop()) / operations;
+  return phase;
+}
+
+template <typename List>
+Result run(const std::vector<int>& keys, const std::vector<int>& lookups, const std::vector<int>& removals,
+           size_t expectedHits, CacheMissCounter& counter) {
+  Result result;
+  AllocationStats before = allocationStats;
+  List list;
+  result.insert = measure(counter, keys.size(), [&] {
+    for (int key : keys) list.insert(key);
+  });
+  result.bytesPerKey = static_cast<double>(allocationStats.liveBytes - before.liveBytes) / keys.size();
+  result.allocationsPerKey = static_cast<double>(allocationStats.allocations - before.allocations) / keys.size();
+
+  size_t hits = 0;
+  result.contains = measure(counter, lookups.size(), [&] {
+    for (int key : lookups) hits += list.contains(key);
+  });
+
+  result.remove = measure(counter, removals.size(), [&] {
+    for (int key : removals) list.remove(key);
+  });
+
+  bool removed = true;
+  for (int key : removals) removed = removed && !list.contains(key);
+  result.valid = hits == expectedHits && removed;
+  return result;
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<size_t> sizes = {100, 1000, 10000, 100000};
+  size_t lookupCount = 2000;
+  std::string csvPath = "data/dictionary_benchmark.csv";
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string flag = argv[i];
+    if (flag == "--sizes") {
+      sizes = parseSizes(argv[i + 1]);
+    } else if (flag == "--lookups") {
+      lookupCount = parseSizes(argv[i + 1]).at(0);
+    } else if (flag == "--csv") {
+      csvPath = argv[i + 1];
+    } else {
+      std::cerr << "Unknown option: " << flag << std::endl;
+      return 1;
+    }
+  }
+
+  ensureParentDirectory(csvPath);
+  std::ofstream csv(csvPath);
+  csv << "list,size,insert_ns,contains_ns,remove_ns,bytes_per_key,allocations_per_key,insert_cache_misses,"
+         "contains_cache_misses,remove_cache_misses,valid\n";
+  bool allValid = true;
+  CacheMissCounter counter;
+  if (!counter.available()) {
+    std::cout << "perf_event_open is not available; cache misses are not reported" << std::endl;
+  }
+
+  for (size_t size : sizes) {
+    std::mt19937 rng(size);
+    std::unordered_set<int> seen;
+    std::vector<int> keys;
+    while (keys.size() < size) {
+      int key = static_cast<int>(rng() >> 1);
+      if (seen.insert(key).second) keys.push_back(key);
+    }
+
+    std::vector<int> lookups;
+    size_t expectedHits = 0;
+    while (lookups.size() < lookupCount) {
+      if (lookups.size() % 2 == 0) {
+        lookups.push_back(keys[rng() % size]);
+        expectedHits++;
+      } else {
+        int key = static_cast<int>(rng() >> 1);
+        expectedHits += seen.count(key);
+        lookups.push_back(key);
+      }
+    }
+
+    std::vector<int> removals = keys;
+    std::shuffle(removals.begin(), removals.end(), rng);
+    removals.resize(std::max<size_t>(std::min(lookupCount / 2, size), 1));
+
+    struct Contender {
+      std::string name;
+      Result (*run)(const std::vector<int>&, const std::vector<int>&, const std::vector<int>&, size_t,
+                     CacheMissCounter&);
+    };
+    const std::vector<Contender> contenders = {
+        {"SinglyLinkedList", run<SinglyLinkedList>},
+        {"DoublyLinkedList", run<DoublyLinkedList>},
+        {"CursorSinglyLinkedList", run<CursorSinglyLinkedList>},
+        {"CursorDoublyLinkedList", run<CursorDoublyLinkedList>},
+        {"CursorSinglyLinkedListVector", run<CursorSinglyLinkedListVector>},
+        {"CursorDoublyLinkedListVector", run<CursorDoublyLinkedListVector>},
+        {"CursorSoALinkedList", run<CursorSoALinkedList>},
+        {"UnrolledLinkedList", run<UnrolledLinkedList>},
+    };
+
+    for (const Contender& contender : contenders) {
+      Result result = contender.run(keys, lookups, removals, expectedHits, counter);
+      allValid = allValid && result.valid;
+      std::cout << size << " / " << contender.name << ": insert " << result.insert.ns << " ns, contains "
+                << result.contains.ns << " ns, remove " << result.remove.ns << " ns, " << result.bytesPerKey
+                << " bytes/key" << (result.valid ? "" : " INVALID RESULT") << std::endl;
+      csv << contender.name << ',' << size << ',' << result.insert.ns << ',' << result.contains.ns << ','
+          << result.remove.ns << ',' << result.bytesPerKey << ',' << result.allocationsPerKey << ',';
+      if (counter.available()) {
+        csv << result.insert.cacheMisses << ',' << result.contains.cacheMisses << ',' << result.remove.cacheMisses;
+      } else {
+        csv << ",,";
+      }
+      csv << ',' << (result.valid ? "true" : "false") << '\n';
+    }
+  }
+
+  std::cout << "Results saved to " << csvPath << std::endl;
+  return allValid ? 0 : 1;
+}
@@ -0,0 +1,62 @@
+#ifndef BENCHMARK_UTILS_H
+#define BENCHMARK_UTILS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Helpers shared by the dictionary benchmarks in this directory.
+
+template <typename F>
+double timeNs(F&& f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+inline void ensureParentDirectory(const std::string& path) {
+  std::filesystem::path parent = std::filesystem::path(path).parent_path();
+  if (!parent.empty()) {
+    std::filesystem::create_directories(parent);
+  }
+}
+
+inline std::vector<size_t> parseSizes(const std::string& list) {
+  std::vector<size_t> sizes;
+  std::stringstream stream(list);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    sizes.push_back(static_cast<size_t>(std::stod(item)));  // Accepts 1e7 as well as 10000000
+  }
+  return sizes;
+}
+
+// `count` keys drawn Zipf-distributed (exponent `skew`) over a random ranking of `keys`, so the hot
+// keys are scattered over the key range
+inline std::vector<int> zipfQueries(const std::vector<int>& keys, size_t count, double skew, std::mt19937_64& rng) {
+  std::vector<int> ranking = keys;
+  std::shuffle(ranking.begin(), ranking.end(), rng);
+  std::vector<double> cumulative(ranking.size());
+  double total = 0;
+  for (size_t rank = 0; rank < ranking.size(); rank++) {
+    total += 1.0 / std::pow(static_cast<double>(rank + 1), skew);
+    cumulative[rank] = total;
+  }
+
+  std::uniform_real_distribution<double> uniform(0, total);
+  std::vector<int> queries(count);
+  for (auto& query : queries) {
+    size_t rank = std::lower_bound(cumulative.begin(), cumulative.end(), uniform(rng)) - cumulative.begin();
+    query = ranking[std::min(rank, ranking.size() - 1)];
+  }
+  return queries;
+}
+
+#endif  // BENCHMARK_UTILS_H
@@ -1,73 +1,91 @@
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <iterator>
+#include <stdexcept>
 
 struct CursorNode {
-  int key;
-  int next;
+  int32_t key;
+  int32_t next;
 
-  CursorNode(int k = 0, int n = -1)
+  CursorNode(int32_t k = 0, int32_t n = -1)
       : key(k), next(n) {
   }
 };
 
+static_assert(sizeof(CursorNode) == 8, "A cursor node should be a key and a 32-bit cursor");
+
 class CursorSinglyLinkedList {
  private:
   CursorNode* nodes;
-  int head;
-  int free;
-  int maxSize;
-
-  void expand() {
-    int oldSize = maxSize;
-    maxSize *= 2;
+  int32_t head;
+  int32_t free;
+  int32_t maxSize;
+  int32_t count;
+
+  // Moves the nodes to an array of `capacity` slots and links the new ones in front of the free
+  // list, so growing costs only the copy and the new slots
+  void expand(size_t capacity) {
+    if (capacity > INT32_MAX) {
+      throw std::length_error("CursorSinglyLinkedList: more than 2^31 - 1 nodes");
+    }
+    int32_t oldSize = maxSize;
+    maxSize = static_cast<int32_t>(capacity);
 
     CursorNode* newNodes = new CursorNode[maxSize];
-    for (int i = 0; i < oldSize; i++) {
-      newNodes[i] = nodes[i];
-    }
-    for (int i = oldSize; i < maxSize - 1; ++i) {
+    std::copy(nodes, nodes + oldSize, newNodes);
+    for (int32_t i = oldSize; i < maxSize - 1; ++i) {
       newNodes[i].next = i + 1;
     }
-    newNodes[maxSize - 1].next = -1;
+    newNodes[maxSize - 1].next = free;
 
     delete[] nodes;
     nodes = newNodes;
-
-    if (free == -1) {
-      free = oldSize;
-    } else {
-      int current = free;
-      while (nodes[current].next != -1) {
-        current = nodes[current].next;
-      }
-      nodes[current].next = oldSize;
-    }
+    free = oldSize;
   }
 
  public:
-  CursorSinglyLinkedList(int size = 5)
-      : head(-1), free(0), maxSize(size) {
-    nodes = new CursorNode[size];
-    for (int i = 0; i < size - 1; ++i) {
-      nodes[i].next = i + 1;
+  CursorSinglyLinkedList(int size = 16)
+      : nodes(nullptr), head(-1), free(-1), maxSize(0), count(0) {
+    expand(std::max(size, 1));
+  }
+
+  // Makes room for `n` keys in total with at most one reallocation
+  void reserve(size_t n) {
+    if (n > static_cast<size_t>(maxSize)) {
+      expand(n);
     }
-    nodes[size - 1].next = -1;
   }
 
   void insert(int key) {
     if (free == -1) {
-      expand();
+      // Doubles up to the 2^31 - 1 nodes an int32_t cursor can address
+      if (maxSize == INT32_MAX) {
+        throw std::length_error("CursorSinglyLinkedList: more than 2^31 - 1 nodes");
+      }
+      expand(std::min<int64_t>(2 * static_cast<int64_t>(maxSize), INT32_MAX));
     }
 
-    int newNode = free;
+    int32_t newNode = free;
     free = nodes[free].next;
 
     nodes[newNode].key = key;
     nodes[newNode].next = head;
     head = newNode;
+    count++;
+  }
+
+  // Same as inserting the keys one by one; needs forward iterators, as the range is counted first
+  template <typename It>
+  void insertRange(It first, It last) {
+    reserve(count + static_cast<size_t>(std::distance(first, last)));
+    for (; first != last; ++first) {
+      insert(*first);
+    }
   }
 
   bool contains(int key) const {
-    int current = head;
+    int32_t current = head;
     while (current != -1) {
       if (nodes[current].key == key) return true;
       current = nodes[current].next;
@@ -76,8 +94,8 @@ class CursorSinglyLinkedList {
   }
 
   void remove(int key) {
-    int current = head;
-    int prev = -1;
+    int32_t current = head;
+    int32_t prev = -1;
 
     while (current != -1) {
       if (nodes[current].key == key) {
@@ -89,6 +107,7 @@ class CursorSinglyLinkedList {
 
         nodes[current].next = free;
         free = current;
+        count--;
         return;
       }
       prev = current;
@@ -96,8 +115,16 @@ class CursorSinglyLinkedList {
     }
   }
 
+  size_t size() const {
+    return count;
+  }
+
+  size_t capacity() const {
+    return maxSize;
+  }
+
   void print() const {
-    int current = head;
+    int32_t current = head;
     while (current != -1) {
       std::cout << nodes[current].key << " ";
       current = nodes[current].next;
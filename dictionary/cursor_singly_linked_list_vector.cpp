@@ -1,49 +1,63 @@
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <iterator>
+#include <stdexcept>
 #include <vector>
 
 struct CursorNodeVector {
-  int key;
-  int next;
+  int32_t key;
+  int32_t next;
 
-  CursorNodeVector(int k = 0, int n = -1)
+  CursorNodeVector(int32_t k = 0, int32_t n = -1)
       : key(k), next(n) {
   }
 };
 
+static_assert(sizeof(CursorNodeVector) == 8, "A cursor node should be a key and a 32-bit cursor");
+
 class CursorSinglyLinkedListVector {
  private:
   std::vector<CursorNodeVector> nodes;
-  int head;
-  int free;
-  int maxSize;
+  int32_t head;
+  int32_t free;
+  int32_t count;
+
+  // Links the new slots [nodes.size(), capacity) in front of the free list, so growing costs only
+  // the new slots
+  void grow(size_t capacity) {
+    if (capacity > INT32_MAX) {
+      throw std::length_error("CursorSinglyLinkedListVector: more than 2^31 - 1 nodes");
+    }
+    int32_t oldSize = static_cast<int32_t>(nodes.size());
+    int32_t newSize = static_cast<int32_t>(capacity);
+    nodes.resize(newSize, CursorNodeVector());
 
- public:
-  CursorSinglyLinkedListVector()
-      : nodes(5, CursorNodeVector()), head(-1), free(0), maxSize(5) {
-    for (int i = 0; i < maxSize - 1; ++i) {
+    for (int32_t i = oldSize; i < newSize - 1; ++i) {
       nodes[i].next = i + 1;
     }
-    nodes[maxSize - 1].next = -1;
+    nodes[newSize - 1].next = free;
+    free = oldSize;
   }
 
-  void resize() {
-    int oldSize = maxSize;
-    maxSize *= 2;
-    nodes.resize(maxSize, CursorNodeVector());
+ public:
+  CursorSinglyLinkedListVector(int size = 16)
+      : head(-1), free(-1), count(0) {
+    grow(std::max(size, 1));
+  }
 
-    for (int i = oldSize; i < maxSize - 1; ++i) {
-      nodes[i].next = i + 1;
+  // Doubles the capacity, up to the 2^31 - 1 nodes an int32_t cursor can address
+  void resize() {
+    if (nodes.size() == INT32_MAX) {
+      throw std::length_error("CursorSinglyLinkedListVector: more than 2^31 - 1 nodes");
     }
-    nodes[maxSize - 1].next = -1;
+    grow(std::min<int64_t>(2 * static_cast<int64_t>(nodes.size()), INT32_MAX));
+  }
 
-    if (free == -1) {
-      free = oldSize;
-    } else {
-      int current = free;
-      while (nodes[current].next != -1) {
-        current = nodes[current].next;
-      }
-      nodes[current].next = oldSize;
+  // Makes room for `n` keys in total with at most one reallocation
+  void reserve(size_t n) {
+    if (n > nodes.size()) {
+      grow(n);
     }
   }
 
@@ -52,16 +66,26 @@ class CursorSinglyLinkedListVector {
       resize();
     }
 
-    int newNode = free;
+    int32_t newNode = free;
     free = nodes[free].next;
 
     nodes[newNode].key = key;
     nodes[newNode].next = head;
     head = newNode;
+    count++;
+  }
+
+  // Same as inserting the keys one by one; needs forward iterators, as the range is counted first
+  template <typename It>
+  void insertRange(It first, It last) {
+    reserve(count + static_cast<size_t>(std::distance(first, last)));
+    for (; first != last; ++first) {
+      insert(*first);
+    }
   }
 
   bool contains(int key) const {
-    int current = head;
+    int32_t current = head;
     while (current != -1) {
       if (nodes[current].key == key) return true;
       current = nodes[current].next;
@@ -70,8 +94,8 @@ class CursorSinglyLinkedListVector {
   }
 
   void remove(int key) {
-    int current = head;
-    int prev = -1;
+    int32_t current = head;
+    int32_t prev = -1;
 
     while (current != -1) {
       if (nodes[current].key == key) {
@@ -83,6 +107,7 @@ class CursorSinglyLinkedListVector {
 
         nodes[current].next = free;
         free = current;
+        count--;
         return;
       }
       prev = current;
@@ -90,16 +115,24 @@ class CursorSinglyLinkedListVector {
     }
   }
 
+  size_t size() const {
+    return count;
+  }
+
+  size_t capacity() const {
+    return nodes.size();
+  }
+
   ~CursorSinglyLinkedListVector() {
     nodes.clear();
   }
 
   void printList() {
-    int current = head;
+    int32_t current = head;
     while (current != -1) {
       std::cout << nodes[current].key << " ";
       current = nodes[current].next;
     }
     std::cout << std::endl;
   }
-};
\ No newline at end of file
+};
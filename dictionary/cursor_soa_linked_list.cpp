@@ -0,0 +1,150 @@
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Cursor list in structure-of-arrays form: keys[i], next[i] and prev[i] describe the node at dense
+// position i, and positions 0..size() - 1 are all in use. contains() therefore scans the key array
+// front to back with SIMD compares instead of following cursors. Removing a node moves the last
+// one into its position and repoints the moved node's neighbours, so insert and unlink are O(1)
+// and the arrays never have holes. List order (newest first) is kept through next/prev, so
+// printList() matches the other lists; remove() takes out one copy of a duplicated key, not
+// necessarily the newest.
+class CursorSoALinkedList {
+ private:
+  std::vector<int32_t> keys;
+  std::vector<int32_t> next;
+  std::vector<int32_t> prev;
+  int32_t head;
+
+  // Dense position of some copy of `key`, or -1
+  int32_t find(int key) const {
+    const int32_t* data = keys.data();
+    size_t count = keys.size();
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i needle = _mm256_set1_epi32(key);
+    for (; i + 16 <= count; i += 16) {
+      __m256i low = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), needle);
+      __m256i high = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 8)), needle);
+      int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_or_si256(low, high)));
+      if (mask) {
+        // Tells only which lane matched, not which half
+        int lane = __builtin_ctz(mask);
+        return static_cast<int32_t>(data[i + lane] == key ? i + lane : i + 8 + lane);
+      }
+    }
+#elif defined(__SSE2__)
+    const __m128i needle = _mm_set1_epi32(key);
+    for (; i + 4 <= count; i += 4) {
+      __m128i lanes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+      int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(lanes, needle)));
+      if (mask) {
+        return static_cast<int32_t>(i + __builtin_ctz(mask));
+      }
+    }
+#endif
+    for (; i < count; i++) {
+      if (data[i] == key) return static_cast<int32_t>(i);
+    }
+    return -1;
+  }
+
+  void unlink(int32_t position) {
+    if (prev[position] != -1) {
+      next[prev[position]] = next[position];
+    } else {
+      head = next[position];
+    }
+    if (next[position] != -1) {
+      prev[next[position]] = prev[position];
+    }
+  }
+
+ public:
+  CursorSoALinkedList()
+      : head(-1) {
+  }
+
+  // Makes room for `n` keys in total with at most one reallocation of each array
+  void reserve(size_t n) {
+    keys.reserve(n);
+    next.reserve(n);
+    prev.reserve(n);
+  }
+
+  void insert(int key) {
+    if (keys.size() == INT32_MAX) {
+      throw std::length_error("CursorSoALinkedList: more than 2^31 - 1 nodes");
+    }
+    int32_t newNode = static_cast<int32_t>(keys.size());
+    keys.push_back(key);
+    next.push_back(head);
+    prev.push_back(-1);
+
+    if (head != -1) prev[head] = newNode;
+    head = newNode;
+  }
+
+  // Same as inserting the keys one by one; needs forward iterators, as the range is counted first
+  template <typename It>
+  void insertRange(It first, It last) {
+    reserve(keys.size() + static_cast<size_t>(std::distance(first, last)));
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  bool contains(int key) const {
+    return find(key) != -1;
+  }
+
+  void remove(int key) {
+    int32_t position = find(key);
+    if (position == -1) {
+      return;
+    }
+    unlink(position);
+
+    // The last node fills the hole; whoever pointed at it now points at its new position
+    int32_t last = static_cast<int32_t>(keys.size()) - 1;
+    if (position != last) {
+      keys[position] = keys[last];
+      next[position] = next[last];
+      prev[position] = prev[last];
+      if (prev[position] != -1) {
+        next[prev[position]] = position;
+      } else {
+        head = position;
+      }
+      if (next[position] != -1) {
+        prev[next[position]] = position;
+      }
+    }
+    keys.pop_back();
+    next.pop_back();
+    prev.pop_back();
+  }
+
+  size_t size() const {
+    return keys.size();
+  }
+
+  size_t capacity() const {
+    return keys.capacity();
+  }
+
+  void printList() const {
+    int32_t current = head;
+    while (current != -1) {
+      std::cout << keys[current] << " ";
+      current = next[current];
+    }
+    std::cout << std::endl;
+  }
+};
@@ -1,37 +1,111 @@
+#include <cstdint>
 #include <iostream>
+#include <utility>
+
+#include "self_organizing.h"
 
 struct DoubleNode {
   int key;
+  uint32_t hits;  // Successful lookups, for SelfOrganizingMode::Count
   DoubleNode* next;
   DoubleNode* prev;
 
   DoubleNode(int _key)
-      : key(_key), next(nullptr), prev(nullptr) {
+      : key(_key), hits(0), next(nullptr), prev(nullptr) {
   }
 };
 
 class DoublyLinkedList {
  private:
   DoubleNode* head;
+  DoubleNode* tail;
+  SelfOrganizingMode mode;
+  SearchStats searchStats;
+
+  void unlink(DoubleNode* node) {
+    if (node->prev) node->prev->next = node->next;
+    if (node->next) node->next->prev = node->prev;
+    if (node == head) head = node->next;
+    if (node == tail) tail = node->prev;
+  }
+
+  // Links `node` right after `before`, or at the head if `before` is nullptr
+  void linkAfter(DoubleNode* before, DoubleNode* node) {
+    node->prev = before;
+    node->next = before ? before->next : head;
+    if (node->next) {
+      node->next->prev = node;
+    } else {
+      tail = node;
+    }
+    if (before) {
+      before->next = node;
+    } else {
+      head = node;
+    }
+  }
+
+  void reorganize(DoubleNode* current) {
+    switch (mode) {
+      case SelfOrganizingMode::None:
+        break;
+      case SelfOrganizingMode::MoveToFront:
+        if (current != head) {
+          unlink(current);
+          linkAfter(nullptr, current);
+        }
+        break;
+      case SelfOrganizingMode::Transpose:
+        if (current->prev) {
+          std::swap(current->prev->key, current->key);
+        }
+        break;
+      case SelfOrganizingMode::Count: {
+        current->hits++;
+        DoubleNode* before = current->prev;
+        while (before && before->hits < current->hits) {
+          before = before->prev;
+        }
+        if (before != current->prev) {
+          unlink(current);
+          linkAfter(before, current);
+        }
+        break;
+      }
+    }
+  }
 
  public:
-  DoublyLinkedList()
-      : head(nullptr) {
+  DoublyLinkedList(SelfOrganizingMode _mode = SelfOrganizingMode::None)
+      : head(nullptr), tail(nullptr), mode(_mode) {
+  }
+
+  // Switching to Count starts every key's count from 0
+  void setMode(SelfOrganizingMode newMode) {
+    mode = newMode;
+    for (DoubleNode* current = head; current; current = current->next) {
+      current->hits = 0;
+    }
   }
 
   void insert(int key) {
     DoubleNode* newNode = new DoubleNode(key);
-    newNode->next = head;
-    if (head) head->prev = newNode;
-    head = newNode;
+    linkAfter(mode == SelfOrganizingMode::Count ? tail : nullptr, newNode);
   }
 
   bool contains(int key) {
     DoubleNode* current = head;
+    uint64_t depth = 0;
     while (current) {
-      if (current->key == key) return true;
+      depth++;
+      if (current->key == key) {
+        searchStats.record(depth, true);
+        reorganize(current);
+        return true;
+      }
       current = current->next;
     }
+    searchStats.record(depth, false);
     return false;
   }
 
@@ -40,9 +114,7 @@ class DoublyLinkedList {
 
     while (current) {
       if (current->key == key) {
-        if (current->prev) current->prev->next = current->next;
-        if (current->next) current->next->prev = current->prev;
-        if (current == head) head = current->next;
+        unlink(current);
         delete current;
         return;
       }
@@ -50,6 +122,14 @@ class DoublyLinkedList {
     }
   }
 
+  const SearchStats& stats() const {
+    return searchStats;
+  }
+
+  void resetStats() {
+    searchStats = SearchStats();
+  }
+
   ~DoublyLinkedList() {
     while (head) {
       DoubleNode* temp = head;
@@ -66,4 +146,4 @@ class DoublyLinkedList {
     }
     std::cout << std::endl;
   }
-};
\ No newline at end of file
+};
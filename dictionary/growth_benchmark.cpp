@@ -0,0 +1,99 @@
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "benchmark_utils.h"
+#include "cursor_doubly_linked_list.cpp"
+#include "cursor_doubly_linked_list_vector.cpp"
+#include "cursor_singly_linked_list.cpp"
+#include "cursor_singly_linked_list_vector.cpp"
+
+// Growth of the cursor lists from empty to `size` nodes, three ways:
+//
+//   insert       insert() one key at a time from the default capacity, doubling as needed
+//   reserve      reserve(size) first, then insert() one key at a time
+//   insertRange  one insertRange() call over all keys
+//
+// Reports ns per key and the node array's final size in bytes per key. The list must hold `size`
+// keys afterwards, with the first and the last one findable.
+//
+//   ./growth_benchmark [--sizes 1e6,1e7] [--csv data/growth_benchmark.csv]
+
+struct Result {
+  double nsPerKey = 0;
+  double bytesPerKey = 0;
+  bool valid = false;
+};
+
+template <typename List, size_t NodeBytes>
+Result grow(const std::vector<int>& keys, const std::string& mode) {
+  Result result;
+  List list;
+  double ns = timeNs([&] {
+    if (mode == "insertRange") {
+      list.insertRange(keys.begin(), keys.end());
+      return;
+    }
+    if (mode == "reserve") {
+      list.reserve(keys.size());
+    }
+    for (int key : keys) list.insert(key);
+  });
+  result.nsPerKey = ns / keys.size();
+  result.bytesPerKey = static_cast<double>(list.capacity()) * NodeBytes / keys.size();
+  result.valid = list.size() == keys.size() && list.contains(keys.front()) && list.contains(keys.back());
+  return result;
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<size_t> sizes = {1000000, 10000000};
+  std::string csvPath = "data/growth_benchmark.csv";
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string flag = argv[i];
+    if (flag == "--sizes") {
+      sizes = parseSizes(argv[i + 1]);
+    } else if (flag == "--csv") {
+      csvPath = argv[i + 1];
+    } else {
+      std::cerr << "Unknown option: " << flag << std::endl;
+      return 1;
+    }
+  }
+
+  ensureParentDirectory(csvPath);
+  std::ofstream csv(csvPath);
+  csv << "list,mode,size,ns_per_key,bytes_per_key,valid\n";
+  bool allValid = true;
+
+  struct Contender {
+    std::string name;
+    Result (*grow)(const std::vector<int>&, const std::string&);
+  };
+  const std::vector<Contender> contenders = {
+      {"CursorSinglyLinkedList", grow<CursorSinglyLinkedList, sizeof(CursorNode)>},
+      {"CursorDoublyLinkedList", grow<CursorDoublyLinkedList, sizeof(CursorDoubleNode)>},
+      {"CursorSinglyLinkedListVector", grow<CursorSinglyLinkedListVector, sizeof(CursorNodeVector)>},
+      {"CursorDoublyLinkedListVector", grow<CursorDoublyLinkedListVector, sizeof(CursorDoubleNodeVector)>},
+  };
+
+  for (size_t size : sizes) {
+    std::vector<int> keys(size);
+    std::iota(keys.begin(), keys.end(), 0);
+
+    for (const Contender& contender : contenders) {
+      for (const std::string mode : {"insert", "reserve", "insertRange"}) {
+        Result result = contender.grow(keys, mode);
+        allValid = allValid && result.valid;
+        std::cout << size << " / " << contender.name << " / " << mode << ": " << result.nsPerKey << " ns/key, "
+                  << result.bytesPerKey << " B/key" << (result.valid ? "" : " INVALID RESULT") << std::endl;
+        csv << contender.name << ',' << mode << ',' << size << ',' << result.nsPerKey << ',' << result.bytesPerKey
+            << ',' << (result.valid ? "true" : "false") << '\n';
+      }
+    }
+  }
+
+  std::cout << "Results saved to " << csvPath << std::endl;
+  return allValid ? 0 : 1;
+}
@@ -0,0 +1,287 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <new>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "EpochReclamation.h"
+
+// Ordered dictionary of ints that any number of threads may use at once. insert, remove and
+// contains take no locks; the expected cost of each is O(log n).
+//
+// This is the lock-free skip list of Herlihy and Shavit. Every link carries a mark bit in its
+// lowest bit, and a node is logically deleted once the link out of its bottom level is marked;
+// remove marks the node's links from the top down, and any search that passes a marked node
+// unlinks it. contains never writes. Unlinked nodes are freed through an EpochDomain.
+//
+// Towers grow with probability 1/4 per level rather than 1/2: a node averages 1.33 links instead
+// of 2, and a node of height h takes 16 + 8h bytes, allocated at 32-byte alignment up to height 2
+// and 64-byte alignment above. 15 in 16 nodes are at most 32 bytes, and no node below height 7
+// straddles a cache line.
+class LockFreeSkipList {
+ private:
+  static constexpr int MAX_HEIGHT = 16;  // Enough for 4^16 keys
+
+  struct Node {
+    int key;
+    int height;
+    // The inserter and a successful remover each give up one share once they stop touching the
+    // node's links; the last one retires it
+    std::atomic<int> owners;
+    int padding;
+
+    Node(int k, int h)
+        : key(k), height(h), owners(2), padding(0) {
+    }
+
+    std::atomic<uintptr_t>* links() {
+      return reinterpret_cast<std::atomic<uintptr_t>*>(this + 1);
+    }
+
+    static size_t alignmentFor(int height) {
+      return sizeof(Node) + height * sizeof(std::atomic<uintptr_t>) <= 32 ? 32 : 64;
+    }
+
+    static Node* create(int key, int height) {
+      size_t alignment = alignmentFor(height);
+      size_t bytes = (sizeof(Node) + height * sizeof(std::atomic<uintptr_t>) + alignment - 1) / alignment * alignment;
+      Node* node = new (::operator new(bytes, std::align_val_t(alignment))) Node(key, height);
+      for (int level = 0; level < height; level++) {
+        new (node->links() + level) std::atomic<uintptr_t>(0);
+      }
+      return node;
+    }
+
+    static void destroy(void* pointer) {
+      Node* node = static_cast<Node*>(pointer);
+      size_t alignment = alignmentFor(node->height);
+      node->~Node();
+      ::operator delete(pointer, std::align_val_t(alignment));
+    }
+  };
+
+  static_assert(sizeof(Node) == 16, "The node header should take 16 bytes");
+
+  static Node* pointer(uintptr_t link) {
+    return reinterpret_cast<Node*>(link & ~uintptr_t(1));
+  }
+
+  static bool marked(uintptr_t link) {
+    return link & 1;
+  }
+
+  static uintptr_t linkTo(Node* node, bool mark = false) {
+    return reinterpret_cast<uintptr_t>(node) | uintptr_t(mark);
+  }
+
+  Node* head;  // Sentinels: head is before every key, tail after every key
+  Node* tail;
+  std::atomic<ptrdiff_t> count;  // May dip below 0 while a remove overtakes the insert it undoes
+  mutable EpochDomain epochs;
+
+  bool before(const Node* node, int key) const {
+    return node != tail && node->key < key;
+  }
+
+  static int randomHeight() {
+    static thread_local std::mt19937_64 rng(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    uint64_t bits = rng() | (uint64_t(1) << (2 * (MAX_HEIGHT - 1)));
+    return 1 + __builtin_ctzll(bits) / 2;
+  }
+
+  // Fills preds/succs with the nodes around `key` on every level, unlinking marked nodes on the
+  // way, and reports whether succs[0] holds `key`
+  bool find(int key, Node** preds, Node** succs) {
+  retry:
+    Node* pred = head;
+    for (int level = MAX_HEIGHT - 1; level >= 0; level--) {
+      Node* curr = pointer(pred->links()[level].load(std::memory_order_acquire));
+      while (true) {
+        uintptr_t succ = curr == tail ? 0 : curr->links()[level].load(std::memory_order_acquire);
+        while (marked(succ)) {
+          uintptr_t expected = linkTo(curr);
+          if (!pred->links()[level].compare_exchange_strong(expected, linkTo(pointer(succ)))) {
+            goto retry;
+          }
+          curr = pointer(succ);
+          succ = curr == tail ? 0 : curr->links()[level].load(std::memory_order_acquire);
+        }
+        if (!before(curr, key)) {
+          break;
+        }
+        pred = curr;
+        curr = pointer(succ);
+      }
+      preds[level] = pred;
+      succs[level] = curr;
+    }
+    return succs[0] != tail && succs[0]->key == key;
+  }
+
+  void release(Node* node) {
+    if (node->owners.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      epochs.retire(node, Node::destroy);
+    }
+  }
+
+ public:
+  LockFreeSkipList()
+      : head(Node::create(0, MAX_HEIGHT)), tail(Node::create(0, MAX_HEIGHT)), count(0) {
+    for (int level = 0; level < MAX_HEIGHT; level++) {
+      head->links()[level].store(linkTo(tail));
+    }
+  }
+
+  LockFreeSkipList(const LockFreeSkipList&) = delete;
+  LockFreeSkipList& operator=(const LockFreeSkipList&) = delete;
+
+  // No operation may still be running; nodes already retired are freed by the EpochDomain
+  ~LockFreeSkipList() {
+    Node* node = pointer(head->links()[0].load());
+    while (node != tail) {
+      Node* next = pointer(node->links()[0].load());
+      Node::destroy(node);
+      node = next;
+    }
+    Node::destroy(head);
+    Node::destroy(tail);
+  }
+
+  // Returns false if `key` was already present
+  bool insert(int key) {
+    EpochDomain::Guard guard(epochs);
+    Node* preds[MAX_HEIGHT];
+    Node* succs[MAX_HEIGHT];
+    int height = randomHeight();
+    Node* node = nullptr;
+
+    while (true) {
+      if (find(key, preds, succs)) {
+        if (node) {
+          Node::destroy(node);  // Never published
+        }
+        return false;
+      }
+      if (!node) {
+        node = Node::create(key, height);
+      }
+      for (int level = 0; level < height; level++) {
+        node->links()[level].store(linkTo(succs[level]), std::memory_order_relaxed);
+      }
+      uintptr_t expected = linkTo(succs[0]);
+      if (preds[0]->links()[0].compare_exchange_strong(expected, linkTo(node))) {
+        break;
+      }
+    }
+    count.fetch_add(1, std::memory_order_relaxed);
+
+    // The node is in the set now; the upper levels only speed up searches
+    for (int level = 1; level < height; level++) {
+      while (true) {
+        uintptr_t link = node->links()[level].load(std::memory_order_acquire);
+        if (marked(link)) {
+          break;  // Being removed; no point in linking it higher
+        }
+        if (pointer(link) != succs[level] &&
+            !node->links()[level].compare_exchange_strong(link, linkTo(succs[level]))) {
+          break;  // Marked in between
+        }
+        uintptr_t expected = linkTo(succs[level]);
+        if (preds[level]->links()[level].compare_exchange_strong(expected, linkTo(node))) {
+          break;
+        }
+        find(key, preds, succs);
+      }
+    }
+
+    // A remover may have unlinked the node before this thread linked some level; unlink it again
+    if (marked(node->links()[0].load(std::memory_order_acquire))) {
+      find(key, preds, succs);
+    }
+    release(node);
+    return true;
+  }
+
+  // Returns false if `key` was not present
+  bool remove(int key) {
+    EpochDomain::Guard guard(epochs);
+    Node* preds[MAX_HEIGHT];
+    Node* succs[MAX_HEIGHT];
+    if (!find(key, preds, succs)) {
+      return false;
+    }
+    Node* victim = succs[0];
+
+    for (int level = victim->height - 1; level >= 1; level--) {
+      uintptr_t link = victim->links()[level].load(std::memory_order_acquire);
+      while (!marked(link)) {
+        victim->links()[level].compare_exchange_weak(link, link | 1);
+      }
+    }
+
+    // Whoever marks the bottom link has removed the key
+    uintptr_t link = victim->links()[0].load(std::memory_order_acquire);
+    while (!marked(link)) {
+      if (victim->links()[0].compare_exchange_weak(link, link | 1)) {
+        count.fetch_sub(1, std::memory_order_relaxed);
+        find(key, preds, succs);  // Unlinks it everywhere
+        release(victim);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool contains(int key) const {
+    EpochDomain::Guard guard(epochs);
+    Node* pred = head;
+    Node* curr = nullptr;
+    for (int level = MAX_HEIGHT - 1; level >= 0; level--) {
+      curr = pointer(pred->links()[level].load(std::memory_order_acquire));
+      while (true) {
+        uintptr_t succ = curr == tail ? 0 : curr->links()[level].load(std::memory_order_acquire);
+        while (marked(succ)) {
+          curr = pointer(succ);
+          succ = curr == tail ? 0 : curr->links()[level].load(std::memory_order_acquire);
+        }
+        if (!before(curr, key)) {
+          break;
+        }
+        pred = curr;
+        curr = pointer(succ);
+      }
+    }
+    return curr != tail && curr->key == key;
+  }
+
+  // Number of keys; exact only while no update is running
+  size_t size() const {
+    ptrdiff_t keys = count.load(std::memory_order_relaxed);
+    return keys > 0 ? static_cast<size_t>(keys) : 0;
+  }
+
+  // Keys in ascending order. Under concurrent updates each key present throughout the call is
+  // included.
+  std::vector<int> toSortedVector() const {
+    EpochDomain::Guard guard(epochs);
+    std::vector<int> keys;
+    for (Node* node = pointer(head->links()[0].load(std::memory_order_acquire)); node != tail;) {
+      uintptr_t next = node->links()[0].load(std::memory_order_acquire);
+      if (!marked(next)) {
+        keys.push_back(node->key);
+      }
+      node = pointer(next);
+    }
+    return keys;
+  }
+
+  void printList() const {
+    for (int key : toSortedVector()) {
+      std::cout << key << " ";
+    }
+    std::cout << std::endl;
+  }
+};
@@ -1,11 +1,16 @@
 #include <iostream>
+#include <thread>
+#include <vector>
 
 #include "cursor_doubly_linked_list.cpp"
 #include "cursor_doubly_linked_list_vector.cpp"
 #include "cursor_singly_linked_list.cpp"
 #include "cursor_singly_linked_list_vector.cpp"
+#include "cursor_soa_linked_list.cpp"
 #include "doubly_linked_list.cpp"
+#include "lock_free_skip_list.cpp"
 #include "singly_linked_list.cpp"
+#include "unrolled_linked_list.cpp"
 
 int main() {
   SinglyLinkedList singlyList;
@@ -34,6 +39,26 @@ int main() {
   doublyList.printList();
   std::cout << std::endl;
 
+  SinglyLinkedList moveToFrontList(SelfOrganizingMode::MoveToFront);
+  std::cout << "Singly Linked List (move-to-front)" << std::endl;
+  for (int key = 10; key <= 50; key += 10) moveToFrontList.insert(key);
+  for (int key : {10, 10, 20, 10, 60}) moveToFrontList.contains(key);
+  std::cout << "Order after looking up 10, 10, 20, 10, 60: ";
+  moveToFrontList.printList();
+  std::cout << "Average search depth: " << moveToFrontList.stats().averageDepth()
+            << ", average hit position: " << moveToFrontList.stats().averageHitPosition()
+            << ", hit rate: " << moveToFrontList.stats().hitRate() << std::endl;
+  std::cout << std::endl;
+
+  DoublyLinkedList countList(SelfOrganizingMode::Count);
+  std::cout << "Doubly Linked List (count)" << std::endl;
+  for (int key = 10; key <= 50; key += 10) countList.insert(key);
+  for (int key : {30, 50, 50, 40, 30, 50}) countList.contains(key);
+  std::cout << "Order after looking up 30, 50, 50, 40, 30, 50: ";
+  countList.printList();
+  std::cout << "Average search depth: " << countList.stats().averageDepth() << std::endl;
+  std::cout << std::endl;
+
   CursorSinglyLinkedListVector cursorSinglyListVector;
   std::cout << "Cursor Singly Linked List (Vector)" << std::endl;
   cursorSinglyListVector.insert(10);
@@ -86,5 +111,52 @@ int main() {
   cursorDoublyListVector.printList();
   std::cout << std::endl;
 
+  CursorSoALinkedList cursorSoAList;
+  std::cout << "Cursor Linked List (Structure of Arrays)" << std::endl;
+  cursorSoAList.insert(70);
+  cursorSoAList.insert(80);
+  cursorSoAList.insert(90);
+
+  std::cout << "Contains 70: " << (cursorSoAList.contains(70) ? "YES" : "NO") << std::endl;
+  cursorSoAList.remove(70);
+  std::cout << "Contains 70 after deletion: " << (cursorSoAList.contains(70) ? "YES" : "NO") << "\n";
+  std::cout << "Cursor Linked List (Structure of Arrays) contains: ";
+  cursorSoAList.printList();
+  std::cout << std::endl;
+
+  UnrolledLinkedList unrolledList;
+  std::cout << "Unrolled Linked List" << std::endl;
+  for (int key = 1; key <= 30; key++) {
+    unrolledList.insert(key);
+  }
+
+  std::cout << "Contains 20: " << (unrolledList.contains(20) ? "YES" : "NO") << std::endl;
+  unrolledList.remove(20);
+  std::cout << "Contains 20 after deletion: " << (unrolledList.contains(20) ? "YES" : "NO") << "\n";
+  std::cout << "Unrolled Linked List contains (" << unrolledList.chunkCount() << " chunks): ";
+  unrolledList.printList();
+  std::cout << std::endl;
+
+  LockFreeSkipList skipList;
+  std::cout << "Lock-Free Skip List" << std::endl;
+  std::vector<std::thread> writers;
+  for (int t = 0; t < 4; t++) {
+    writers.emplace_back([&skipList, t] {
+      for (int key = t; key < 40; key += 4) {
+        skipList.insert(key);
+      }
+    });
+  }
+  for (auto& writer : writers) {
+    writer.join();
+  }
+
+  std::cout << "Contains 20: " << (skipList.contains(20) ? "YES" : "NO") << std::endl;
+  skipList.remove(20);
+  std::cout << "Contains 20 after deletion: " << (skipList.contains(20) ? "YES" : "NO") << "\n";
+  std::cout << "Lock-Free Skip List contains: ";
+  skipList.printList();
+  std::cout << std::endl;
+
   return 0;
 }
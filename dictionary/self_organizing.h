@@ -0,0 +1,45 @@
+#ifndef SELF_ORGANIZING_H
+#define SELF_ORGANIZING_H
+
+#include <cstdint>
+
+// How SinglyLinkedList and DoublyLinkedList reorder themselves after a successful contains():
+//
+//   None         keep insertion order (newest first)
+//   MoveToFront  the key found moves to the head
+//   Transpose    the key found swaps places with the one before it
+//   Count        keys stay sorted by how often they were found, most often first; a key moves
+//                ahead of the others with its old count. New keys go to the tail.
+enum class SelfOrganizingMode { None, MoveToFront, Transpose, Count };
+
+// Counters kept by contains(). Depth is the number of nodes compared; for a hit it is also the
+// key's 1-based position in the list at the time of the lookup.
+struct SearchStats {
+  uint64_t searches = 0;
+  uint64_t hits = 0;
+  uint64_t totalDepth = 0;
+  uint64_t totalHitPosition = 0;
+
+  void record(uint64_t depth, bool hit) {
+    searches++;
+    totalDepth += depth;
+    if (hit) {
+      hits++;
+      totalHitPosition += depth;
+    }
+  }
+
+  double averageDepth() const {
+    return searches ? static_cast<double>(totalDepth) / searches : 0;
+  }
+
+  double averageHitPosition() const {
+    return hits ? static_cast<double>(totalHitPosition) / hits : 0;
+  }
+
+  double hitRate() const {
+    return searches ? static_cast<double>(hits) / searches : 0;
+  }
+};
+
+#endif  // SELF_ORGANIZING_H
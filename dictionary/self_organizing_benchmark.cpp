@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "benchmark_utils.h"
+#include "doubly_linked_list.cpp"
+#include "singly_linked_list.cpp"
+
+// SinglyLinkedList and DoublyLinkedList in every SelfOrganizingMode against std::unordered_set on
+// a skewed access trace. For each list the output has ns per lookup and, from its SearchStats, the
+// average search depth, the average position of a hit and the hit rate.
+//
+// The synthetic trace draws --lookups keys from `size` distinct keys with Zipf skew --skew, plus
+// --misses percent of lookups for absent keys; the keys are inserted in random order first.
+// --trace replays a recorded trace instead: a file of whitespace-separated int keys, whose
+// distinct keys are inserted in order of first appearance. Every list must report exactly the
+// hits std::unordered_set does.
+//
+//   ./self_organizing_benchmark [--sizes 1e3,1e4] [--lookups 1e6] [--skew 1.0] [--misses 5]
+//                               [--trace keys.txt] [--csv data/self_organizing_benchmark.csv]
+
+struct Result {
+  double lookupNs = 0;
+  size_t hits = 0;
+  SearchStats stats;
+};
+
+template <typename List>
+Result runList(const std::vector<int>& keys, const std::vector<int>& lookups, SelfOrganizingMode mode) {
+  Result result;
+  List list(mode);
+  for (int key : keys) list.insert(key);
+  result.lookupNs = timeNs([&] {
+                      for (int key : lookups) result.hits += list.contains(key);
+                    }) /
+                    lookups.size();
+  result.stats = list.stats();
+  return result;
+}
+
+Result runHash(const std::vector<int>& keys, const std::vector<int>& lookups) {
+  Result result;
+  std::unordered_set<int> set(keys.begin(), keys.end());
+  result.lookupNs = timeNs([&] {
+                      for (int key : lookups) result.hits += set.count(key);
+                    }) /
+                    lookups.size();
+  return result;
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<size_t> sizes = {1000, 10000};
+  size_t lookupCount = 1000000;
+  double skew = 1.0;
+  size_t missPercent = 5;
+  std::string tracePath;
+  std::string csvPath = "data/self_organizing_benchmark.csv";
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string flag = argv[i];
+    if (flag == "--sizes") {
+      sizes = parseSizes(argv[i + 1]);
+    } else if (flag == "--lookups") {
+      lookupCount = parseSizes(argv[i + 1]).at(0);
+    } else if (flag == "--skew") {
+      skew = std::stod(argv[i + 1]);
+    } else if (flag == "--misses") {
+      missPercent = parseSizes(argv[i + 1]).at(0);
+    } else if (flag == "--trace") {
+      tracePath = argv[i + 1];
+    } else if (flag == "--csv") {
+      csvPath = argv[i + 1];
+    } else {
+      std::cerr << "Unknown option: " << flag << std::endl;
+      return 1;
+    }
+  }
+
+  // Each entry is one trace: the keys to insert and the lookups to replay
+  std::vector<std::pair<std::vector<int>, std::vector<int>>> traces;
+  if (!tracePath.empty()) {
+    std::ifstream file(tracePath);
+    if (!file) {
+      std::cerr << "Cannot open trace: " << tracePath << std::endl;
+      return 1;
+    }
+    std::vector<int> keys;
+    std::vector<int> lookups;
+    std::unordered_set<int> seen;
+    int key;
+    while (file >> key) {
+      if (seen.insert(key).second) keys.push_back(key);
+      lookups.push_back(key);
+    }
+    if (lookups.empty()) {
+      std::cerr << "Empty trace: " << tracePath << std::endl;
+      return 1;
+    }
+    traces.emplace_back(keys, lookups);
+  } else {
+    for (size_t size : sizes) {
+      std::mt19937_64 rng(size);
+      std::vector<int> keys(size);
+      for (size_t i = 0; i < size; i++) keys[i] = static_cast<int>(i);
+      std::shuffle(keys.begin(), keys.end(), rng);
+      std::vector<int> lookups = zipfQueries(keys, lookupCount, skew, rng);
+      for (auto& key : lookups) {
+        if (rng() % 100 < missPercent) key = -1 - static_cast<int>(rng() % size);
+      }
+      traces.emplace_back(keys, lookups);
+    }
+  }
+
+  ensureParentDirectory(csvPath);
+  std::ofstream csv(csvPath);
+  csv << "list,mode,size,lookups,lookup_ns,average_depth,average_hit_position,hit_rate,valid\n";
+  bool allValid = true;
+
+  const std::vector<std::pair<std::string, SelfOrganizingMode>> modes = {
+      {"none", SelfOrganizingMode::None},
+      {"move-to-front", SelfOrganizingMode::MoveToFront},
+      {"transpose", SelfOrganizingMode::Transpose},
+      {"count", SelfOrganizingMode::Count},
+  };
+
+  for (const auto& [keys, lookups] : traces) {
+    Result hash = runHash(keys, lookups);
+    std::cout << keys.size() << " keys / " << lookups.size() << " lookups / std::unordered_set: " << hash.lookupNs
+              << " ns" << std::endl;
+    csv << "std::unordered_set,-," << keys.size() << ',' << lookups.size() << ',' << hash.lookupNs << ",,,"
+        << static_cast<double>(hash.hits) / lookups.size() << ",true\n";
+
+    for (const auto& [modeName, mode] : modes) {
+      for (const auto& [name, result] :
+           {std::pair<std::string, Result>{"SinglyLinkedList", runList<SinglyLinkedList>(keys, lookups, mode)},
+            std::pair<std::string, Result>{"DoublyLinkedList", runList<DoublyLinkedList>(keys, lookups, mode)}}) {
+        bool valid = result.hits == hash.hits && result.stats.searches == lookups.size();
+        allValid = allValid && valid;
+        std::cout << keys.size() << " keys / " << lookups.size() << " lookups / " << name << " (" << modeName
+                  << "): " << result.lookupNs << " ns, depth " << result.stats.averageDepth() << ", hit position "
+                  << result.stats.averageHitPosition() << ", hit rate " << result.stats.hitRate()
+                  << (valid ? "" : " INVALID RESULT") << std::endl;
+        csv << name << ',' << modeName << ',' << keys.size() << ',' << lookups.size() << ',' << result.lookupNs << ','
+            << result.stats.averageDepth() << ',' << result.stats.averageHitPosition() << ','
+            << result.stats.hitRate() << ',' << (valid ? "true" : "false") << '\n';
+      }
+    }
+  }
+
+  std::cout << "Results saved to " << csvPath << std::endl;
+  return allValid ? 0 : 1;
+}
@@ -1,35 +1,116 @@
+#include <cstdint>
 #include <iostream>
+#include <utility>
+
+#include "self_organizing.h"
 
 struct Node {
   int key;
+  uint32_t hits;  // Successful lookups, for SelfOrganizingMode::Count
   Node* next;
 
   Node(int _key)
-      : key(_key), next(nullptr) {
+      : key(_key), hits(0), next(nullptr) {
   }
 };
 
 class SinglyLinkedList {
  private:
   Node* head;
+  Node* tail;
+  SelfOrganizingMode mode;
+  SearchStats searchStats;
+
+  // Moves `current`, found after `prev` (nullptr at the head), according to the mode. In Count
+  // mode `runStart` is the first node with the same count as `current`, after `runStartPrev`.
+  void reorganize(Node* prev, Node* current, Node* runStartPrev, Node* runStart) {
+    switch (mode) {
+      case SelfOrganizingMode::None:
+        break;
+      case SelfOrganizingMode::MoveToFront:
+        if (prev) {
+          unlink(prev, current);
+          current->next = head;
+          head = current;
+        }
+        break;
+      case SelfOrganizingMode::Transpose:
+        if (prev) {
+          std::swap(prev->key, current->key);
+        }
+        break;
+      case SelfOrganizingMode::Count:
+        current->hits++;
+        if (runStart != current) {
+          unlink(prev, current);
+          current->next = runStart;
+          if (runStartPrev) {
+            runStartPrev->next = current;
+          } else {
+            head = current;
+          }
+        }
+        break;
+    }
+  }
+
+  void unlink(Node* prev, Node* current) {
+    if (prev) {
+      prev->next = current->next;
+    } else {
+      head = current->next;
+    }
+    if (current == tail) {
+      tail = prev;
+    }
+  }
 
  public:
-  SinglyLinkedList()
-      : head(nullptr) {
+  SinglyLinkedList(SelfOrganizingMode _mode = SelfOrganizingMode::None)
+      : head(nullptr), tail(nullptr), mode(_mode) {
+  }
+
+  // Switching to Count starts every key's count from 0
+  void setMode(SelfOrganizingMode newMode) {
+    mode = newMode;
+    for (Node* current = head; current; current = current->next) {
+      current->hits = 0;
+    }
   }
 
   void insert(int key) {
     Node* newNode = new Node(key);
+    if (mode == SelfOrganizingMode::Count && tail) {
+      tail->next = newNode;
+      tail = newNode;
+      return;
+    }
     newNode->next = head;
     head = newNode;
+    if (!tail) tail = newNode;
   }
 
   bool contains(int key) {
+    Node* prev = nullptr;
     Node* current = head;
+    Node* runStartPrev = nullptr;
+    Node* runStart = head;
+    uint64_t depth = 0;
     while (current) {
-      if (current->key == key) return true;
+      depth++;
+      if (current->key == key) {
+        searchStats.record(depth, true);
+        reorganize(prev, current, runStartPrev, runStart);
+        return true;
+      }
+      prev = current;
       current = current->next;
+      if (current && current->hits != prev->hits) {
+        runStartPrev = prev;
+        runStart = current;
+      }
     }
+    searchStats.record(depth, false);
     return false;
   }
 
@@ -39,11 +120,7 @@ class SinglyLinkedList {
 
     while (current) {
       if (current->key == key) {
-        if (prev) {
-          prev->next = current->next;
-        } else {
-          head = current->next;
-        }
+        unlink(prev, current);
         delete current;
         return;
       }
@@ -52,6 +129,14 @@ class SinglyLinkedList {
     }
   }
 
+  const SearchStats& stats() const {
+    return searchStats;
+  }
+
+  void resetStats() {
+    searchStats = SearchStats();
+  }
+
   ~SinglyLinkedList() {
     while (head) {
       Node* temp = head;
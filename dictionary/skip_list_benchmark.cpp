@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "benchmark_utils.h"
+#include "lock_free_skip_list.cpp"
+
+// Throughput of LockFreeSkipList under several threads and update ratios, against std::set behind
+// a std::shared_mutex (readers share the lock, writers take it exclusively).
+//
+// The dictionary is prefilled with about `size` random keys from [0, 2 * size). Each thread then
+// runs its share of the operations: lookups, and at the given update ratio equally many inserts
+// and removes of random keys, so the size stays roughly constant. Afterwards the skip list must be
+// strictly ordered, and its size must equal the prefill plus the successful inserts minus the
+// successful removes that the threads counted. Lookups count their hits; when the operations run in
+// a fixed order (one thread, or no updates) both dictionaries must report the same hits.
+//
+//   ./skip_list_benchmark [--size 1e6] [--operations 2e6] [--threads 1,2,4,8] [--updates 0,10,50]
+//                         [--csv data/skip_list_benchmark.csv]
+
+class LockedSet {
+  std::set<int> keys;
+  mutable std::shared_mutex mutex;
+
+ public:
+  bool insert(int key) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    return keys.insert(key).second;
+  }
+
+  bool contains(int key) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return keys.count(key) != 0;
+  }
+
+  bool remove(int key) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    return keys.erase(key) != 0;
+  }
+
+  size_t size() const {
+    return keys.size();
+  }
+};
+
+// Returns the time taken; `expectedSize` gets the size the successful updates add up to and `hits`
+// the number of lookups that found their key
+template <typename Dictionary>
+double run(Dictionary& dictionary, size_t size, size_t operations, size_t threads, int updatePercent,
+           long& expectedSize, size_t& hits) {
+  int range = static_cast<int>(2 * size);
+  std::mt19937_64 fill(size);
+  expectedSize = 0;
+  for (size_t i = 0; i < size; i++) {
+    expectedSize += dictionary.insert(static_cast<int>(fill() % range));
+  }
+
+  // Operation streams are generated up front so the timed part only touches the dictionary
+  std::vector<std::vector<int>> keys(threads);
+  std::vector<std::vector<char>> kinds(threads);  // 'c' contains, 'i' insert, 'r' remove
+  for (size_t t = 0; t < threads; t++) {
+    std::mt19937_64 rng(size * 31 + t);
+    size_t share = operations / threads;
+    keys[t].resize(share);
+    kinds[t].resize(share);
+    for (size_t i = 0; i < share; i++) {
+      keys[t][i] = static_cast<int>(rng() % range);
+      int roll = static_cast<int>(rng() % 200);
+      kinds[t][i] = roll >= 2 * updatePercent ? 'c' : roll % 2 ? 'i' : 'r';
+    }
+  }
+
+  std::vector<long> net(threads);
+  std::vector<size_t> found(threads);
+  double ns = timeNs([&] {
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; t++) {
+      workers.emplace_back([&, t] {
+        // Counted locally: per-operation writes to neighbouring slots of `found` would share a cache line
+        long added = 0;
+        size_t hitCount = 0;
+        for (size_t i = 0; i < keys[t].size(); i++) {
+          int key = keys[t][i];
+          if (kinds[t][i] == 'c') {
+            hitCount += dictionary.contains(key);
+          } else if (kinds[t][i] == 'i') {
+            added += dictionary.insert(key);
+          } else {
+            added -= dictionary.remove(key);
+          }
+        }
+        net[t] = added;
+        found[t] = hitCount;
+      });
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  });
+  for (long added : net) expectedSize += added;
+  hits = 0;
+  for (size_t count : found) hits += count;
+  return ns;
+}
+
+int main(int argc, char* argv[]) {
+  size_t size = 1000000;
+  size_t operations = 2000000;
+  std::vector<size_t> threadCounts = {1, 2, 4, 8};
+  std::vector<size_t> updatePercents = {0, 10, 50};
+  std::string csvPath = "data/skip_list_benchmark.csv";
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string flag = argv[i];
+    if (flag == "--size") {
+      size = parseSizes(argv[i + 1]).at(0);
+    } else if (flag == "--operations") {
+      operations = parseSizes(argv[i + 1]).at(0);
+    } else if (flag == "--threads") {
+      threadCounts = parseSizes(argv[i + 1]);
+    } else if (flag == "--updates") {
+      updatePercents = parseSizes(argv[i + 1]);
+    } else if (flag == "--csv") {
+      csvPath = argv[i + 1];
+    } else {
+      std::cerr << "Unknown option: " << flag << std::endl;
+      return 1;
+    }
+  }
+
+  ensureParentDirectory(csvPath);
+  std::ofstream csv(csvPath);
+  csv << "dictionary,threads,update_percent,size,operations,mops_per_s,hits,valid\n";
+  bool allValid = true;
+  std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+
+  for (size_t updates : updatePercents) {
+    for (size_t threads : threadCounts) {
+      long skipListSize = 0;
+      size_t skipListHits = 0;
+      LockFreeSkipList skipList;
+      double skipListNs =
+          run(skipList, size, operations, threads, static_cast<int>(updates), skipListSize, skipListHits);
+      long lockedSize = 0;
+      size_t lockedHits = 0;
+      LockedSet locked;
+      double lockedNs = run(locked, size, operations, threads, static_cast<int>(updates), lockedSize, lockedHits);
+
+      std::vector<int> keys = skipList.toSortedVector();
+      bool ordered = std::adjacent_find(keys.begin(), keys.end(), std::greater_equal<int>()) == keys.end();
+      bool valid = ordered && static_cast<long>(keys.size()) == skipListSize && skipList.size() == keys.size() &&
+                   static_cast<long>(locked.size()) == lockedSize &&
+                   (skipListHits == lockedHits || (threads > 1 && updates > 0));
+      allValid = allValid && valid;
+
+      size_t done = operations / threads * threads;
+      struct Row {
+        std::string name;
+        double ns;
+        size_t hits;
+      };
+      for (const Row& row : {Row{"LockFreeSkipList", skipListNs, skipListHits},
+                             Row{"std::set+shared_mutex", lockedNs, lockedHits}}) {
+        double mops = done / row.ns * 1e3;
+        std::cout << updates << "% updates / " << threads << " threads / " << row.name << ": " << mops
+                  << " Mops/s, " << row.hits << " hits" << (valid ? "" : " INVALID RESULT") << std::endl;
+        csv << row.name << ',' << threads << ',' << updates << ',' << size << ',' << done << ',' << mops << ','
+            << row.hits << ',' << (valid ? "true" : "false") << '\n';
+      }
+    }
+  }
+
+  std::cout << "Results saved to " << csvPath << std::endl;
+  return allValid ? 0 : 1;
+}
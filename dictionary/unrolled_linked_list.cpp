@@ -0,0 +1,163 @@
+#include <cstring>
+#include <iostream>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "NodePool.h"
+
+// One cache line: up to 12 keys, oldest first, so the newest key of the chunk is keys[count - 1]
+struct alignas(64) UnrolledChunk {
+  static constexpr int CAPACITY = 12;
+  static constexpr int HALF = CAPACITY / 2;
+
+  int keys[CAPACITY];
+  int count;
+  UnrolledChunk* next;
+
+  UnrolledChunk()
+      : keys{}, count(0), next(nullptr) {
+  }
+
+  // Index of the newest copy of `key` among the used slots, or -1
+  int find(int key) const {
+#ifdef __SSE2__
+    // The chunk is 64-byte aligned, so its 12 keys are three aligned 16-byte loads
+    const __m128i needle = _mm_set1_epi32(key);
+    const __m128i* lanes = reinterpret_cast<const __m128i*>(keys);
+    int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_load_si128(lanes), needle))) |
+               _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_load_si128(lanes + 1), needle))) << 4 |
+               _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_load_si128(lanes + 2), needle))) << 8;
+    mask &= (1 << count) - 1;
+    return mask ? 31 - __builtin_clz(mask) : -1;
+#else
+    for (int i = count - 1; i >= 0; i--) {
+      if (keys[i] == key) return i;
+    }
+    return -1;
+#endif
+  }
+};
+
+static_assert(sizeof(UnrolledChunk) == 64, "UnrolledChunk should fill exactly one cache line");
+
+// Same interface and order as SinglyLinkedList (insert at the head, remove the first match), but
+// keys are packed 12 to a chunk, so a scan takes one cache miss per 12 keys instead of one per
+// key. Chunks come from a NodePool. Every chunk except a lone one stays at least half full:
+// inserting into a full head chunk splits it, and a remove that leaves a chunk under half full
+// borrows a key from a neighbour or merges the two.
+class UnrolledLinkedList {
+ private:
+  UnrolledChunk* head;
+  NodePool<UnrolledChunk> pool;
+  size_t keyCount;
+
+  // Restores the fill invariant for `chunk` after a remove; `prev` is the chunk before it
+  void rebalance(UnrolledChunk* prev, UnrolledChunk* chunk) {
+    if (chunk->count >= UnrolledChunk::HALF) {
+      return;
+    }
+
+    if (UnrolledChunk* next = chunk->next) {
+      if (chunk->count + next->count <= UnrolledChunk::CAPACITY) {
+        // Chunk's keys are newer than next's, so they go after them
+        std::memcpy(next->keys + next->count, chunk->keys, chunk->count * sizeof(int));
+        next->count += chunk->count;
+        (prev ? prev->next : head) = next;
+        pool.destroy(chunk);
+      } else {
+        // Next's newest key becomes chunk's oldest
+        std::memmove(chunk->keys + 1, chunk->keys, chunk->count * sizeof(int));
+        chunk->keys[0] = next->keys[--next->count];
+        chunk->count++;
+      }
+    } else if (prev) {
+      if (prev->count + chunk->count <= UnrolledChunk::CAPACITY) {
+        std::memmove(prev->keys + chunk->count, prev->keys, prev->count * sizeof(int));
+        std::memcpy(prev->keys, chunk->keys, chunk->count * sizeof(int));
+        prev->count += chunk->count;
+        prev->next = nullptr;
+        pool.destroy(chunk);
+      } else {
+        // Prev's oldest key becomes chunk's newest
+        chunk->keys[chunk->count++] = prev->keys[0];
+        prev->count--;
+        std::memmove(prev->keys, prev->keys + 1, prev->count * sizeof(int));
+      }
+    } else if (chunk->count == 0) {
+      head = nullptr;
+      pool.destroy(chunk);
+    }
+  }
+
+ public:
+  UnrolledLinkedList()
+      : head(nullptr), keyCount(0) {
+  }
+
+  UnrolledLinkedList(const UnrolledLinkedList&) = delete;
+  UnrolledLinkedList& operator=(const UnrolledLinkedList&) = delete;
+
+  void insert(int key) {
+    if (!head) {
+      head = pool.create();
+    } else if (head->count == UnrolledChunk::CAPACITY) {
+      // The newer half moves to a new head chunk
+      UnrolledChunk* chunk = pool.create();
+      std::memcpy(chunk->keys, head->keys + UnrolledChunk::HALF, UnrolledChunk::HALF * sizeof(int));
+      chunk->count = UnrolledChunk::HALF;
+      head->count = UnrolledChunk::HALF;
+      chunk->next = head;
+      head = chunk;
+    }
+    head->keys[head->count++] = key;
+    keyCount++;
+  }
+
+  bool contains(int key) const {
+    for (const UnrolledChunk* chunk = head; chunk; chunk = chunk->next) {
+      if (chunk->find(key) >= 0) return true;
+    }
+    return false;
+  }
+
+  void remove(int key) {
+    UnrolledChunk* prev = nullptr;
+    for (UnrolledChunk* chunk = head; chunk; chunk = chunk->next) {
+      int index = chunk->find(key);
+      if (index >= 0) {
+        std::memmove(chunk->keys + index, chunk->keys + index + 1, (chunk->count - index - 1) * sizeof(int));
+        chunk->count--;
+        keyCount--;
+        rebalance(prev, chunk);
+        return;
+      }
+      prev = chunk;
+    }
+  }
+
+  size_t size() const {
+    return keyCount;
+  }
+
+  size_t chunkCount() const {
+    return pool.size();
+  }
+
+  size_t bytesReserved() const {
+    return pool.bytesReserved();
+  }
+
+  // Chunks are trivially destructible, so the pool drops them slab by slab
+  ~UnrolledLinkedList() = default;
+
+  void printList() const {
+    for (const UnrolledChunk* chunk = head; chunk; chunk = chunk->next) {
+      for (int i = chunk->count - 1; i >= 0; i--) {
+        std::cout << chunk->keys[i] << " ";
+      }
+    }
+    std::cout << std::endl;
+  }
+};
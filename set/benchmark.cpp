@@ -1,5 +1,6 @@
 #include "headers/dictionary-simple.hpp"
 #include "headers/set-linked.hpp"
+#include "headers/set-roaring.hpp"
 #include "headers/set-simple.hpp"
 
 #include <chrono>
@@ -315,6 +316,256 @@ class DictionarySimpleBenchmark {
   }
 };
 
+// The std::vector<bool> layout SetSimple used before it packed its bits into words by hand; kept as
+// the baseline for SetSimpleAlgebraBenchmark
+class VectorBoolSet {
+  private:
+  int n;
+  std::vector<bool> elements;
+
+  public:
+  VectorBoolSet(int N) : n(N), elements(N, false) {}
+
+  void insert(int x) {
+    elements[x] = true;
+  }
+
+  VectorBoolSet operator+(const VectorBoolSet &other) const {
+    VectorBoolSet result(n);
+    for (int i = 0; i < n; i++) {
+      result.elements[i] = elements[i] || other.elements[i];
+    }
+    return result;
+  }
+
+  VectorBoolSet operator*(const VectorBoolSet &other) const {
+    VectorBoolSet result(n);
+    for (int i = 0; i < n; i++) {
+      result.elements[i] = elements[i] && other.elements[i];
+    }
+    return result;
+  }
+
+  VectorBoolSet operator-(const VectorBoolSet &other) const {
+    VectorBoolSet result(n);
+    for (int i = 0; i < n; i++) {
+      result.elements[i] = elements[i] && !other.elements[i];
+    }
+    return result;
+  }
+
+  bool operator==(const VectorBoolSet &other) const {
+    for (int i = 0; i < n; i++) {
+      if (elements[i] != other.elements[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  int size() const {
+    int count = 0;
+    for (int i = 0; i < n; i++) {
+      count += elements[i];
+    }
+    return count;
+  }
+};
+
+// Union, intersection, difference and equality of two half-full sets over [0, N), for SetSimple
+// against VectorBoolSet. Each operation runs `repeats` times; both results must have the same
+// number of elements. Writes data/algebra_<Operation>.txt.
+class SetSimpleAlgebraBenchmark {
+  private:
+  std::mt19937 rng;
+
+  template <typename F>
+  double timeMs(int repeats, F f) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < repeats; i++) {
+      f();
+    }
+    auto endTime = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(endTime - startTime).count() / repeats;
+  }
+
+  public:
+  SetSimpleAlgebraBenchmark() : rng(12345) {}
+
+  void runAllTests() {
+    std::vector<int> sizes = {10000, 100000, 1000000};
+    std::vector<std::string> operations = {"Union", "Intersection", "Difference", "Equality"};
+    const int repeats = 20;
+
+    for (const auto &op : operations) {
+      std::ofstream file("data/algebra_" + op + ".txt");
+      file << "# N VectorBool(ms) Bitset(ms) Speedup" << std::endl;
+
+      for (int n : sizes) {
+        SetSimple a(n), b(n);
+        VectorBoolSet oldA(n), oldB(n);
+        for (int i = 0; i < n; i++) {
+          if (rng() % 2) {
+            a.insert(i);
+            oldA.insert(i);
+          }
+          if (rng() % 2) {
+            b.insert(i);
+            oldB.insert(i);
+          }
+        }
+
+        SetSimple bitsetResult(0);
+        VectorBoolSet vectorBoolResult(0);
+        bool bitsetEqual = false;
+        bool vectorBoolEqual = false;
+        double bitsetMs = 0;
+        double vectorBoolMs = 0;
+        if (op == "Union") {
+          bitsetMs = timeMs(repeats, [&] { bitsetResult = a + b; });
+          vectorBoolMs = timeMs(repeats, [&] { vectorBoolResult = oldA + oldB; });
+        } else if (op == "Intersection") {
+          bitsetMs = timeMs(repeats, [&] { bitsetResult = a * b; });
+          vectorBoolMs = timeMs(repeats, [&] { vectorBoolResult = oldA * oldB; });
+        } else if (op == "Difference") {
+          bitsetMs = timeMs(repeats, [&] { bitsetResult = a - b; });
+          vectorBoolMs = timeMs(repeats, [&] { vectorBoolResult = oldA - oldB; });
+        } else {
+          SetSimple copy = a;
+          VectorBoolSet oldCopy = oldA;
+          bitsetMs = timeMs(repeats, [&] { bitsetEqual = a == copy; });
+          vectorBoolMs = timeMs(repeats, [&] { vectorBoolEqual = oldA == oldCopy; });
+        }
+
+        bool valid = bitsetResult.size() == static_cast<size_t>(vectorBoolResult.size()) &&
+                     bitsetEqual == vectorBoolEqual;
+        std::cout << op << " N=" << n << ": std::vector<bool> " << vectorBoolMs << " ms, bitset " << bitsetMs
+                  << " ms, speedup " << vectorBoolMs / bitsetMs << "x" << (valid ? "" : " INVALID RESULT")
+                  << std::endl;
+        file << n << " " << vectorBoolMs << " " << bitsetMs << " " << vectorBoolMs / bitsetMs << std::endl;
+      }
+    }
+  }
+};
+
+// SetLinked, SetSimple and SetRoaring on sets over [0, 2^26): "Sparse" draws values uniformly,
+// "Clustered" takes stretches of 256 consecutive values at random places. For each size the
+// three build two such sets (SetRoaring calls runOptimize() as part of the build), look up every
+// value of the first, and take their union and intersection. Memory is what each structure holds: a SetLinked
+// node per element, SetSimple's N bits, SetRoaring's bytesUsed(). Every lookup must succeed, and
+// SetRoaring and SetSimple must agree on the sizes of the results.
+// Writes data/roaring_<Workload>_<Operation>.txt and data/roaring_<Workload>_Memory.txt.
+class RoaringComparisonBenchmark {
+  private:
+  static const int DOMAIN = 1 << 26;
+  std::mt19937 rng;
+
+  std::vector<int> generate(const std::string &workload, int size) {
+    std::vector<int> values;
+    while (static_cast<int>(values.size()) < size) {
+      if (workload == "Sparse") {
+        values.push_back(static_cast<int>(rng() % DOMAIN));
+      } else {
+        int start = static_cast<int>(rng() % (DOMAIN - 256));
+        for (int i = 0; i < 256 && static_cast<int>(values.size()) < size; i++) {
+          values.push_back(start + i);
+        }
+      }
+    }
+    return values;
+  }
+
+  template <typename F>
+  double timeMs(F f) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    f();
+    auto endTime = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(endTime - startTime).count();
+  }
+
+  public:
+  RoaringComparisonBenchmark() : rng(2024) {}
+
+  void runAllTests() {
+    std::vector<int> sizes = {1000, 5000, 10000};
+    std::vector<std::string> workloads = {"Sparse", "Clustered"};
+    std::vector<std::string> operations = {"Insert", "Search", "Union", "Intersection"};
+
+    for (const auto &workload : workloads) {
+      std::vector<std::ofstream> files;
+      for (const auto &op : operations) {
+        files.emplace_back("data/roaring_" + workload + "_" + op + ".txt");
+        files.back() << "# Size Linked(ms) Simple(ms) Roaring(ms)" << std::endl;
+      }
+      std::ofstream memoryFile("data/roaring_" + workload + "_Memory.txt");
+      memoryFile << "# Size Linked(KB) Simple(KB) Roaring(KB)" << std::endl;
+
+      for (int size : sizes) {
+        std::vector<int> first = generate(workload, size);
+        std::vector<int> second = generate(workload, size);
+        double ms[4][3] = {};
+        size_t found[3] = {};
+
+        SetLinked linkedA, linkedB;
+        ms[0][0] = timeMs([&] {
+          for (int val : first) linkedA.insert(val);
+          for (int val : second) linkedB.insert(val);
+        });
+        ms[1][0] = timeMs([&] {
+          for (int val : first) found[0] += linkedA.contains(val);
+        });
+        ms[2][0] = timeMs([&] { SetLinked result = linkedA + linkedB; });
+        ms[3][0] = timeMs([&] { SetLinked result = linkedA * linkedB; });
+
+        SetSimple simpleA(DOMAIN), simpleB(DOMAIN);
+        size_t simpleUnion = 0;
+        size_t simpleIntersection = 0;
+        ms[0][1] = timeMs([&] {
+          for (int val : first) simpleA.insert(val);
+          for (int val : second) simpleB.insert(val);
+        });
+        ms[1][1] = timeMs([&] {
+          for (int val : first) found[1] += simpleA.contains(val);
+        });
+        ms[2][1] = timeMs([&] { simpleUnion = (simpleA + simpleB).size(); });
+        ms[3][1] = timeMs([&] { simpleIntersection = (simpleA * simpleB).size(); });
+
+        SetRoaring roaringA, roaringB;
+        size_t roaringUnion = 0;
+        size_t roaringIntersection = 0;
+        ms[0][2] = timeMs([&] {
+          for (int val : first) roaringA.insert(val);
+          for (int val : second) roaringB.insert(val);
+          roaringA.runOptimize();
+          roaringB.runOptimize();
+        });
+        ms[1][2] = timeMs([&] {
+          for (int val : first) found[2] += roaringA.contains(val);
+        });
+        ms[2][2] = timeMs([&] { roaringUnion = (roaringA + roaringB).size(); });
+        ms[3][2] = timeMs([&] { roaringIntersection = (roaringA * roaringB).size(); });
+
+        bool valid = simpleUnion == roaringUnion && simpleIntersection == roaringIntersection &&
+                     simpleA.size() == roaringA.size() && found[0] == first.size() && found[1] == first.size() &&
+                     found[2] == first.size();
+        for (size_t op = 0; op < operations.size(); op++) {
+          files[op] << size << " " << ms[op][0] << " " << ms[op][1] << " " << ms[op][2] << std::endl;
+          std::cout << workload << " " << operations[op] << " size=" << size << ": SetLinked " << ms[op][0]
+                    << " ms, SetSimple " << ms[op][1] << " ms, SetRoaring " << ms[op][2] << " ms"
+                    << (valid ? "" : " INVALID RESULT") << std::endl;
+        }
+
+        double linkedKb = 2.0 * size * sizeof(Node) / 1024.0;
+        double simpleKb = 2.0 * (DOMAIN / 64) * sizeof(uint64_t) / 1024.0;
+        double roaringKb = (roaringA.bytesUsed() + roaringB.bytesUsed()) / 1024.0;
+        memoryFile << size << " " << linkedKb << " " << simpleKb << " " << roaringKb << std::endl;
+        std::cout << workload << " Memory size=" << size << ": SetLinked " << linkedKb << " KB, SetSimple "
+                  << simpleKb << " KB, SetRoaring " << roaringKb << " KB" << std::endl;
+      }
+    }
+  }
+};
+
 void generateComparisonScripts() {
   std::ofstream insertTimeScript("data/plot_insert_time.gnu");
   insertTimeScript << "set terminal png size 1200,800 enhanced font 'Arial,12'\n";
@@ -520,6 +771,12 @@ int main() {
   DictionarySimpleBenchmark dictBench("Dictionary");
   dictBench.runAllTests();
 
+  SetSimpleAlgebraBenchmark algebraBench;
+  algebraBench.runAllTests();
+
+  RoaringComparisonBenchmark roaringBench;
+  roaringBench.runAllTests();
+
   std::cout << "Benchmarks completed. Data saved to data/ directory.\n";
 
   std::cout << "Generating comparison scripts...\n";
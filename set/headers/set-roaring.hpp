@@ -0,0 +1,640 @@
+#ifndef SET_ROARING_HPP
+#define SET_ROARING_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Compressed set of 32-bit unsigned integers (a Roaring bitmap). The domain is split into 2^16
+// chunks by the high 16 bits of each value, and every non-empty chunk keeps the low 16 bits of its
+// elements in whichever container suits it:
+//
+//   array   sorted values, 2 bytes each; for chunks of at most 4096 elements
+//   bitmap  one bit per possible value, always 8 KB; for denser chunks
+//   run     sorted, disjoint intervals of consecutive values, 4 bytes each
+//
+// insert and remove switch a chunk between array and bitmap at 4096 elements, and extend or split
+// intervals in a run container (which falls back to array or bitmap once it stops being the
+// smallest). Union, intersection and difference use a kernel for each pair of container types
+// and give every result chunk its smallest representation. runOptimize() does the same for all
+// chunks, e.g. after many inserts of consecutive values.
+class SetRoaring {
+  private:
+  enum ContainerType { Array, Bitmap, Run };
+
+  static const int ARRAY_MAX = 4096;  // An array this long is as large as a bitmap
+  static const int BITMAP_WORDS = 1024;
+
+  // The values start .. start + length
+  struct Interval {
+    uint16_t start;
+    uint16_t length;
+
+    uint32_t end() const {
+      return uint32_t(start) + length;
+    }
+  };
+
+  struct Container {
+    ContainerType type;
+    int cardinality;
+    std::vector<uint16_t> array;
+    std::vector<uint64_t> bitmap;
+    std::vector<Interval> runs;
+
+    Container() : type(Array), cardinality(0) {}
+  };
+
+  std::vector<uint16_t> keys;  // High 16 bits of the chunks, ascending
+  std::vector<Container> containers;
+
+  static bool testBit(const std::vector<uint64_t> &bitmap, uint32_t value) {
+    return bitmap[value / 64] >> (value % 64) & 1;
+  }
+
+  // Sets or clears the bits first .. last
+  static void fillRange(std::vector<uint64_t> &bitmap, uint32_t first, uint32_t last, bool set) {
+    uint32_t firstWord = first / 64;
+    uint32_t lastWord = last / 64;
+    for (uint32_t w = firstWord; w <= lastWord; w++) {
+      uint64_t mask = ~uint64_t(0);
+      if (w == firstWord) mask &= ~uint64_t(0) << (first % 64);
+      if (w == lastWord) mask &= ~uint64_t(0) >> (63 - last % 64);
+      bitmap[w] = set ? bitmap[w] | mask : bitmap[w] & ~mask;
+    }
+  }
+
+  static int popcount(const std::vector<uint64_t> &bitmap) {
+    int count = 0;
+    for (size_t i = 0; i < bitmap.size(); i++) {
+      count += __builtin_popcountll(bitmap[i]);
+    }
+    return count;
+  }
+
+  // Appends first .. last to runs, merging it into the last interval if they touch
+  static void appendInterval(std::vector<Interval> &runs, uint32_t first, uint32_t last) {
+    if (!runs.empty() && first <= runs.back().end() + 1) {
+      if (last > runs.back().end()) {
+        runs.back().length = static_cast<uint16_t>(last - runs.back().start);
+      }
+      return;
+    }
+    Interval interval = {static_cast<uint16_t>(first), static_cast<uint16_t>(last - first)};
+    runs.push_back(interval);
+  }
+
+  static void appendValues(const Container &c, std::vector<uint16_t> &values) {
+    if (c.type == Array) {
+      values.insert(values.end(), c.array.begin(), c.array.end());
+    } else if (c.type == Bitmap) {
+      for (int w = 0; w < BITMAP_WORDS; w++) {
+        for (uint64_t bits = c.bitmap[w]; bits; bits &= bits - 1) {
+          values.push_back(static_cast<uint16_t>(w * 64 + __builtin_ctzll(bits)));
+        }
+      }
+    } else {
+      for (size_t i = 0; i < c.runs.size(); i++) {
+        for (uint32_t v = c.runs[i].start; v <= c.runs[i].end(); v++) {
+          values.push_back(static_cast<uint16_t>(v));
+        }
+      }
+    }
+  }
+
+  static std::vector<uint64_t> toBitmapWords(const Container &c) {
+    if (c.type == Bitmap) {
+      return c.bitmap;
+    }
+    std::vector<uint64_t> bitmap(BITMAP_WORDS, 0);
+    if (c.type == Array) {
+      for (size_t i = 0; i < c.array.size(); i++) {
+        bitmap[c.array[i] / 64] |= uint64_t(1) << (c.array[i] % 64);
+      }
+    } else {
+      for (size_t i = 0; i < c.runs.size(); i++) {
+        fillRange(bitmap, c.runs[i].start, c.runs[i].end(), true);
+      }
+    }
+    return bitmap;
+  }
+
+  static size_t countRuns(const Container &c) {
+    if (c.type == Run) {
+      return c.runs.size();
+    }
+    size_t count = 0;
+    if (c.type == Array) {
+      for (size_t i = 0; i < c.array.size(); i++) {
+        count += i == 0 || c.array[i] != c.array[i - 1] + 1;
+      }
+    } else {
+      uint64_t carry = 0;  // Top bit of the previous word
+      for (int w = 0; w < BITMAP_WORDS; w++) {
+        count += __builtin_popcountll(c.bitmap[w] & ~(c.bitmap[w] << 1 | carry));
+        carry = c.bitmap[w] >> 63;
+      }
+    }
+    return count;
+  }
+
+  static void convert(Container &c, ContainerType target) {
+    if (c.type == target) {
+      return;
+    }
+    if (target == Bitmap) {
+      c.bitmap = toBitmapWords(c);
+    } else {
+      std::vector<uint16_t> values;
+      values.reserve(c.cardinality);
+      appendValues(c, values);
+      if (target == Array) {
+        c.array.swap(values);
+      } else {
+        std::vector<Interval> runs;
+        for (size_t i = 0; i < values.size(); i++) {
+          appendInterval(runs, values[i], values[i]);
+        }
+        c.runs.swap(runs);
+      }
+    }
+    if (target != Array) std::vector<uint16_t>().swap(c.array);
+    if (target != Bitmap) std::vector<uint64_t>().swap(c.bitmap);
+    if (target != Run) std::vector<Interval>().swap(c.runs);
+    c.type = target;
+  }
+
+  // The cheaper of array and bitmap for the container's cardinality
+  static ContainerType plainType(const Container &c) {
+    return c.cardinality <= ARRAY_MAX ? Array : Bitmap;
+  }
+
+  static size_t plainBytes(const Container &c) {
+    return c.cardinality <= ARRAY_MAX ? 2 * static_cast<size_t>(c.cardinality) : 8 * BITMAP_WORDS;
+  }
+
+  // Switches to the smallest of the three representations
+  static void optimize(Container &c) {
+    convert(c, 4 * countRuns(c) < plainBytes(c) ? Run : plainType(c));
+  }
+
+  static bool containsLow(const Container &c, uint16_t value) {
+    if (c.type == Array) {
+      return std::binary_search(c.array.begin(), c.array.end(), value);
+    }
+    if (c.type == Bitmap) {
+      return testBit(c.bitmap, value);
+    }
+    size_t i = upperRun(c.runs, value);
+    return i > 0 && value <= c.runs[i - 1].end();
+  }
+
+  // Index of the first value at or after `from` that is not below `value`. The step from `from`
+  // doubles until it passes `value`, then a binary search runs inside the last step.
+  static size_t gallop(const std::vector<uint16_t> &values, size_t from, uint16_t value) {
+    if (from >= values.size() || values[from] >= value) {
+      return from;
+    }
+    size_t low = from;  // values[low] < value
+    size_t step = 1;
+    while (low + step < values.size() && values[low + step] < value) {
+      low += step;
+      step *= 2;
+    }
+    size_t high = std::min(low + step, values.size());
+    return std::lower_bound(values.begin() + low + 1, values.begin() + high, value) - values.begin();
+  }
+
+  // Index of the first interval starting after `value`
+  static size_t upperRun(const std::vector<Interval> &runs, uint16_t value) {
+    size_t low = 0;
+    size_t high = runs.size();
+    while (low < high) {
+      size_t middle = (low + high) / 2;
+      if (runs[middle].start <= value) {
+        low = middle + 1;
+      } else {
+        high = middle;
+      }
+    }
+    return low;
+  }
+
+  static bool addLow(Container &c, uint16_t value) {
+    if (c.type == Array) {
+      std::vector<uint16_t>::iterator it = std::lower_bound(c.array.begin(), c.array.end(), value);
+      if (it != c.array.end() && *it == value) {
+        return false;
+      }
+      c.array.insert(it, value);
+      if (++c.cardinality > ARRAY_MAX) {
+        convert(c, Bitmap);
+      }
+      return true;
+    }
+    if (c.type == Bitmap) {
+      if (testBit(c.bitmap, value)) {
+        return false;
+      }
+      c.bitmap[value / 64] |= uint64_t(1) << (value % 64);
+      c.cardinality++;
+      return true;
+    }
+
+    size_t i = upperRun(c.runs, value);
+    if (i > 0 && value <= c.runs[i - 1].end()) {
+      return false;
+    }
+    if (i > 0 && value == c.runs[i - 1].end() + 1) {
+      c.runs[i - 1].length++;
+      if (i < c.runs.size() && c.runs[i].start == value + 1) {
+        c.runs[i - 1].length += c.runs[i].length + 1;
+        c.runs.erase(c.runs.begin() + i);
+      }
+    } else if (i < c.runs.size() && c.runs[i].start == value + 1) {
+      c.runs[i].start--;
+      c.runs[i].length++;
+    } else {
+      Interval interval = {value, 0};
+      c.runs.insert(c.runs.begin() + i, interval);
+    }
+    c.cardinality++;
+    if (4 * c.runs.size() > plainBytes(c)) {
+      convert(c, plainType(c));
+    }
+    return true;
+  }
+
+  static bool removeLow(Container &c, uint16_t value) {
+    if (c.type == Array) {
+      std::vector<uint16_t>::iterator it = std::lower_bound(c.array.begin(), c.array.end(), value);
+      if (it == c.array.end() || *it != value) {
+        return false;
+      }
+      c.array.erase(it);
+      c.cardinality--;
+      return true;
+    }
+    if (c.type == Bitmap) {
+      if (!testBit(c.bitmap, value)) {
+        return false;
+      }
+      c.bitmap[value / 64] &= ~(uint64_t(1) << (value % 64));
+      if (--c.cardinality <= ARRAY_MAX) {
+        convert(c, Array);
+      }
+      return true;
+    }
+
+    size_t i = upperRun(c.runs, value);
+    if (i == 0 || value > c.runs[i - 1].end()) {
+      return false;
+    }
+    Interval &run = c.runs[i - 1];
+    if (run.length == 0) {
+      c.runs.erase(c.runs.begin() + (i - 1));
+    } else if (value == run.start) {
+      run.start++;
+      run.length--;
+    } else if (value == run.end()) {
+      run.length--;
+    } else {
+      Interval after = {static_cast<uint16_t>(value + 1), static_cast<uint16_t>(run.end() - value - 1)};
+      run.length = static_cast<uint16_t>(value - run.start - 1);
+      c.runs.insert(c.runs.begin() + i, after);
+    }
+    c.cardinality--;
+    if (4 * c.runs.size() > plainBytes(c)) {
+      convert(c, plainType(c));
+    }
+    return true;
+  }
+
+  static Container bitmapContainer(const std::vector<uint64_t> &bitmap) {
+    Container result;
+    result.type = Bitmap;
+    result.bitmap = bitmap;
+    result.cardinality = popcount(bitmap);
+    return result;
+  }
+
+  static Container arrayContainer(std::vector<uint16_t> &values) {
+    Container result;
+    result.array.swap(values);
+    result.cardinality = static_cast<int>(result.array.size());
+    return result;
+  }
+
+  static Container runContainer(std::vector<Interval> &runs) {
+    Container result;
+    result.type = Run;
+    result.runs.swap(runs);
+    for (size_t i = 0; i < result.runs.size(); i++) {
+      result.cardinality += result.runs[i].length + 1;
+    }
+    return result;
+  }
+
+  static Container unite(const Container &a, const Container &b) {
+    Container result;
+    if (a.type == Array && b.type == Array) {
+      std::vector<uint16_t> values(a.array.size() + b.array.size());
+      values.erase(std::set_union(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), values.begin()),
+                   values.end());
+      result = arrayContainer(values);
+    } else if (a.type == Bitmap || b.type == Bitmap) {
+      const Container &dense = a.type == Bitmap ? a : b;
+      const Container &other = a.type == Bitmap ? b : a;
+      std::vector<uint64_t> bitmap = dense.bitmap;
+      if (other.type == Bitmap) {
+        for (int w = 0; w < BITMAP_WORDS; w++) bitmap[w] |= other.bitmap[w];
+      } else if (other.type == Array) {
+        for (size_t i = 0; i < other.array.size(); i++) {
+          bitmap[other.array[i] / 64] |= uint64_t(1) << (other.array[i] % 64);
+        }
+      } else {
+        for (size_t i = 0; i < other.runs.size(); i++) {
+          fillRange(bitmap, other.runs[i].start, other.runs[i].end(), true);
+        }
+      }
+      result = bitmapContainer(bitmap);
+    } else {
+      // Two run containers, or a run and an array: merge intervals in order of their start
+      std::vector<Interval> left = a.runs;
+      std::vector<Interval> right = b.runs;
+      if (a.type == Array) left = asRuns(a);
+      if (b.type == Array) right = asRuns(b);
+      std::vector<Interval> runs;
+      size_t i = 0;
+      size_t j = 0;
+      while (i < left.size() || j < right.size()) {
+        const Interval &next = j == right.size() || (i < left.size() && left[i].start <= right[j].start) ? left[i++]
+                                                                                                          : right[j++];
+        appendInterval(runs, next.start, next.end());
+      }
+      result = runContainer(runs);
+    }
+    optimize(result);
+    return result;
+  }
+
+  static std::vector<Interval> asRuns(const Container &c) {
+    Container copy = c;
+    convert(copy, Run);
+    return copy.runs;
+  }
+
+  static Container intersect(const Container &a, const Container &b) {
+    Container result;
+    if (a.type == Array && b.type == Array) {
+      const std::vector<uint16_t> &small = a.array.size() <= b.array.size() ? a.array : b.array;
+      const std::vector<uint16_t> &large = a.array.size() <= b.array.size() ? b.array : a.array;
+      std::vector<uint16_t> values;
+      if (small.size() * 64 < large.size()) {
+        // Much smaller: gallop through the larger array from the previous match to each of its values
+        size_t from = 0;
+        for (size_t i = 0; i < small.size(); i++) {
+          from = gallop(large, from, small[i]);
+          if (from == large.size()) break;
+          if (large[from] == small[i]) values.push_back(small[i]);
+        }
+      } else {
+        values.resize(small.size());
+        values.erase(std::set_intersection(small.begin(), small.end(), large.begin(), large.end(), values.begin()),
+                     values.end());
+      }
+      result = arrayContainer(values);
+    } else if (a.type == Array || b.type == Array) {
+      const Container &sparse = a.type == Array ? a : b;
+      const Container &other = a.type == Array ? b : a;
+      std::vector<uint16_t> values;
+      if (other.type == Bitmap) {
+        for (size_t i = 0; i < sparse.array.size(); i++) {
+          if (testBit(other.bitmap, sparse.array[i])) values.push_back(sparse.array[i]);
+        }
+      } else {
+        size_t r = 0;
+        for (size_t i = 0; i < sparse.array.size() && r < other.runs.size(); i++) {
+          while (r < other.runs.size() && other.runs[r].end() < sparse.array[i]) r++;
+          if (r < other.runs.size() && other.runs[r].start <= sparse.array[i]) values.push_back(sparse.array[i]);
+        }
+      }
+      result = arrayContainer(values);
+    } else if (a.type == Run && b.type == Run) {
+      std::vector<Interval> runs;
+      size_t i = 0;
+      size_t j = 0;
+      while (i < a.runs.size() && j < b.runs.size()) {
+        uint32_t first = std::max<uint32_t>(a.runs[i].start, b.runs[j].start);
+        uint32_t last = std::min(a.runs[i].end(), b.runs[j].end());
+        if (first <= last) appendInterval(runs, first, last);
+        if (a.runs[i].end() < b.runs[j].end()) {
+          i++;
+        } else {
+          j++;
+        }
+      }
+      result = runContainer(runs);
+    } else {
+      std::vector<uint64_t> bitmap = toBitmapWords(a);
+      std::vector<uint64_t> other = toBitmapWords(b);
+      for (int w = 0; w < BITMAP_WORDS; w++) bitmap[w] &= other[w];
+      result = bitmapContainer(bitmap);
+    }
+    optimize(result);
+    return result;
+  }
+
+  static Container subtract(const Container &a, const Container &b) {
+    Container result;
+    if (a.type == Array) {
+      std::vector<uint16_t> values;
+      if (b.type == Array) {
+        values.resize(a.array.size());
+        values.erase(std::set_difference(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), values.begin()),
+                     values.end());
+      } else {
+        for (size_t i = 0; i < a.array.size(); i++) {
+          if (!containsLow(b, a.array[i])) values.push_back(a.array[i]);
+        }
+      }
+      result = arrayContainer(values);
+    } else {
+      std::vector<uint64_t> bitmap = toBitmapWords(a);
+      if (b.type == Bitmap) {
+        for (int w = 0; w < BITMAP_WORDS; w++) bitmap[w] &= ~b.bitmap[w];
+      } else if (b.type == Array) {
+        for (size_t i = 0; i < b.array.size(); i++) {
+          bitmap[b.array[i] / 64] &= ~(uint64_t(1) << (b.array[i] % 64));
+        }
+      } else {
+        for (size_t i = 0; i < b.runs.size(); i++) {
+          fillRange(bitmap, b.runs[i].start, b.runs[i].end(), false);
+        }
+      }
+      result = bitmapContainer(bitmap);
+    }
+    optimize(result);
+    return result;
+  }
+
+  static bool equalContainers(const Container &a, const Container &b) {
+    if (a.cardinality != b.cardinality) {
+      return false;
+    }
+    if (a.type == b.type) {
+      if (a.type == Array) return a.array == b.array;
+      if (a.type == Bitmap) return a.bitmap == b.bitmap;
+      for (size_t i = 0; i < a.runs.size(); i++) {
+        if (a.runs[i].start != b.runs[i].start || a.runs[i].length != b.runs[i].length) return false;
+      }
+      return a.runs.size() == b.runs.size();
+    }
+    return toBitmapWords(a) == toBitmapWords(b);
+  }
+
+  size_t find(uint16_t high) const {
+    return std::lower_bound(keys.begin(), keys.end(), high) - keys.begin();
+  }
+
+  void append(uint16_t high, const Container &c) {
+    if (c.cardinality > 0) {
+      keys.push_back(high);
+      containers.push_back(c);
+    }
+  }
+
+  public:
+  void insert(uint32_t x) {
+    uint16_t high = static_cast<uint16_t>(x >> 16);
+    size_t i = find(high);
+    if (i == keys.size() || keys[i] != high) {
+      keys.insert(keys.begin() + i, high);
+      containers.insert(containers.begin() + i, Container());
+    }
+    addLow(containers[i], static_cast<uint16_t>(x));
+  }
+
+  void remove(uint32_t x) {
+    uint16_t high = static_cast<uint16_t>(x >> 16);
+    size_t i = find(high);
+    if (i < keys.size() && keys[i] == high && removeLow(containers[i], static_cast<uint16_t>(x)) &&
+        containers[i].cardinality == 0) {
+      keys.erase(keys.begin() + i);
+      containers.erase(containers.begin() + i);
+    }
+  }
+
+  bool contains(uint32_t x) const {
+    uint16_t high = static_cast<uint16_t>(x >> 16);
+    size_t i = find(high);
+    return i < keys.size() && keys[i] == high && containsLow(containers[i], static_cast<uint16_t>(x));
+  }
+
+  // Number of elements
+  size_t size() const {
+    size_t count = 0;
+    for (size_t i = 0; i < containers.size(); i++) {
+      count += containers[i].cardinality;
+    }
+    return count;
+  }
+
+  // Heap and object bytes held by the set, including spare vector capacity
+  size_t bytesUsed() const {
+    size_t bytes = sizeof(*this) + keys.capacity() * sizeof(uint16_t) + containers.capacity() * sizeof(Container);
+    for (size_t i = 0; i < containers.size(); i++) {
+      bytes += containers[i].array.capacity() * sizeof(uint16_t) + containers[i].bitmap.capacity() * sizeof(uint64_t) +
+               containers[i].runs.capacity() * sizeof(Interval);
+    }
+    return bytes;
+  }
+
+  // Gives every chunk its smallest representation, turning stretches of consecutive values into runs
+  void runOptimize() {
+    for (size_t i = 0; i < containers.size(); i++) {
+      optimize(containers[i]);
+    }
+  }
+
+  // Elements in ascending order
+  std::vector<uint32_t> toVector() const {
+    std::vector<uint32_t> result;
+    std::vector<uint16_t> low;
+    for (size_t i = 0; i < containers.size(); i++) {
+      low.clear();
+      appendValues(containers[i], low);
+      for (size_t j = 0; j < low.size(); j++) {
+        result.push_back(uint32_t(keys[i]) << 16 | low[j]);
+      }
+    }
+    return result;
+  }
+
+  SetRoaring operator+(const SetRoaring &other) const {
+    SetRoaring result;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < keys.size() || j < other.keys.size()) {
+      if (j == other.keys.size() || (i < keys.size() && keys[i] < other.keys[j])) {
+        result.append(keys[i], containers[i]);
+        i++;
+      } else if (i == keys.size() || other.keys[j] < keys[i]) {
+        result.append(other.keys[j], other.containers[j]);
+        j++;
+      } else {
+        result.append(keys[i], unite(containers[i], other.containers[j]));
+        i++;
+        j++;
+      }
+    }
+    return result;
+  }
+
+  SetRoaring operator*(const SetRoaring &other) const {
+    SetRoaring result;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < keys.size() && j < other.keys.size()) {
+      if (keys[i] < other.keys[j]) {
+        i++;
+      } else if (other.keys[j] < keys[i]) {
+        j++;
+      } else {
+        result.append(keys[i], intersect(containers[i], other.containers[j]));
+        i++;
+        j++;
+      }
+    }
+    return result;
+  }
+
+  SetRoaring operator-(const SetRoaring &other) const {
+    SetRoaring result;
+    size_t j = 0;
+    for (size_t i = 0; i < keys.size(); i++) {
+      while (j < other.keys.size() && other.keys[j] < keys[i]) j++;
+      if (j < other.keys.size() && other.keys[j] == keys[i]) {
+        result.append(keys[i], subtract(containers[i], other.containers[j]));
+      } else {
+        result.append(keys[i], containers[i]);
+      }
+    }
+    return result;
+  }
+
+  bool operator==(const SetRoaring &other) const {
+    if (keys != other.keys) {
+      return false;
+    }
+    for (size_t i = 0; i < containers.size(); i++) {
+      if (!equalContainers(containers[i], other.containers[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+#endif // SET_ROARING_HPP
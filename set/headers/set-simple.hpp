@@ -1,59 +1,190 @@
 #ifndef SET_SIMPLE_HPP
 #define SET_SIMPLE_HPP
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
 #include <vector>
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// Set of integers from [0, N), one bit per possible element packed into 64-bit words. Union,
+// intersection, difference and comparison work a word at a time, or four words per AVX2
+// instruction when built with -mavx2. Bits at N and above are always zero.
+//
+// Sets with different N can be combined: a + b covers max(a.N, b.N), while a * b and a - b keep
+// a's N, which already holds every element of the result.
 class SetSimple {
   private:
+  enum Operation { Union, Intersection, Difference };
+
   int n;
-  std::vector<bool> elements;
+  std::vector<uint64_t> words;
+
+  static size_t wordCount(int n) {
+    return n > 0 ? (static_cast<size_t>(n) + 63) / 64 : 0;
+  }
+
+  // target[i] = target[i] op source[i] for the first `count` words
+  template <Operation op>
+  static void combine(uint64_t *target, const uint64_t *source, size_t count) {
+    size_t i = 0;
+#ifdef __AVX2__
+    for (size_t vectorEnd = count - count % 4; i < vectorEnd; i += 4) {
+      __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(target + i));
+      __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + i));
+      __m256i result = op == Union          ? _mm256_or_si256(a, b)
+                       : op == Intersection ? _mm256_and_si256(a, b)
+                                            : _mm256_andnot_si256(b, a);
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(target + i), result);
+    }
+#endif
+    for (; i < count; i++) {
+      target[i] = op == Union ? target[i] | source[i] : op == Intersection ? target[i] & source[i] : target[i] & ~source[i];
+    }
+  }
 
   public:
-  SetSimple(int N = 1000000) : n(N), elements(N, false) {}
+  // Visits the elements in ascending order, skipping a whole empty word at a time
+  class const_iterator {
+    private:
+    const std::vector<uint64_t> *words;
+    size_t index;
+    uint64_t remaining;  // Bits of words[index] not visited yet
+
+    void skipEmptyWords() {
+      while (remaining == 0 && index < words->size()) {
+        if (++index < words->size()) {
+          remaining = (*words)[index];
+        }
+      }
+    }
+
+    public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef int value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const int *pointer;
+    typedef int reference;
+
+    const_iterator(const std::vector<uint64_t> *w, size_t i)
+        : words(w), index(i), remaining(i < w->size() ? (*w)[i] : 0) {
+      skipEmptyWords();
+    }
+
+    int operator*() const {
+      return static_cast<int>(index * 64 + __builtin_ctzll(remaining));
+    }
+
+    const_iterator &operator++() {
+      remaining &= remaining - 1;
+      skipEmptyWords();
+      return *this;
+    }
+
+    const_iterator operator++(int) {
+      const_iterator previous = *this;
+      ++*this;
+      return previous;
+    }
+
+    bool operator==(const const_iterator &other) const {
+      return index == other.index && remaining == other.remaining;
+    }
+
+    bool operator!=(const const_iterator &other) const {
+      return !(*this == other);
+    }
+  };
+
+  SetSimple(int N = 1000000) : n(N > 0 ? N : 0), words(wordCount(N), 0) {}
 
   void insert(int x) {
     if (x >= 0 && x < n) {
-      elements[x] = true;
+      words[x / 64] |= uint64_t(1) << (x % 64);
     }
   }
 
   void remove(int x) {
     if (x >= 0 && x < n) {
-      elements[x] = false;
+      words[x / 64] &= ~(uint64_t(1) << (x % 64));
     }
   }
 
   bool contains(int x) const {
-    return (x >= 0 && x < n) ? elements[x] : false;
+    return x >= 0 && x < n && (words[x / 64] >> (x % 64) & 1);
   }
 
-  SetSimple operator+(const SetSimple &other) const {
-    SetSimple result(n);
-    for (int i = 0; i < n; i++) {
-      result.elements[i] = elements[i] || other.elements[i];
+  // Number of elements
+  size_t size() const {
+    size_t count = 0;
+    for (size_t i = 0; i < words.size(); i++) {
+      count += __builtin_popcountll(words[i]);
+    }
+    return count;
+  }
+
+  const_iterator begin() const {
+    return const_iterator(&words, 0);
+  }
+
+  const_iterator end() const {
+    return const_iterator(&words, words.size());
+  }
+
+  // Grows N to other's N if that is larger
+  SetSimple &operator|=(const SetSimple &other) {
+    if (other.n > n) {
+      n = other.n;
+      words.resize(other.words.size(), 0);
     }
+    combine<Union>(words.data(), other.words.data(), other.words.size());
+    return *this;
+  }
+
+  SetSimple &operator&=(const SetSimple &other) {
+    size_t common = std::min(words.size(), other.words.size());
+    combine<Intersection>(words.data(), other.words.data(), common);
+    std::fill(words.begin() + common, words.end(), 0);
+    return *this;
+  }
+
+  SetSimple &operator-=(const SetSimple &other) {
+    combine<Difference>(words.data(), other.words.data(), std::min(words.size(), other.words.size()));
+    return *this;
+  }
+
+  SetSimple operator+(const SetSimple &other) const {
+    SetSimple result(*this);
+    result |= other;
     return result;
   }
 
   SetSimple operator*(const SetSimple &other) const {
-    SetSimple result(n);
-    for (int i = 0; i < n; i++) {
-      result.elements[i] = elements[i] && other.elements[i];
-    }
+    SetSimple result(*this);
+    result &= other;
     return result;
   }
 
   SetSimple operator-(const SetSimple &other) const {
-    SetSimple result(n);
-    for (int i = 0; i < n; i++) {
-      result.elements[i] = elements[i] && !other.elements[i];
-    }
+    SetSimple result(*this);
+    result -= other;
     return result;
   }
 
+  // Compares elements only, so sets with different N but the same elements are equal
   bool operator==(const SetSimple &other) const {
-    for (int i = 0; i < n; i++) {
-      if (elements[i] != other.elements[i]) {
+    const std::vector<uint64_t> &shorter = words.size() <= other.words.size() ? words : other.words;
+    const std::vector<uint64_t> &longer = words.size() <= other.words.size() ? other.words : words;
+    if (!shorter.empty() && std::memcmp(shorter.data(), longer.data(), shorter.size() * sizeof(uint64_t)) != 0) {
+      return false;
+    }
+    for (size_t i = shorter.size(); i < longer.size(); i++) {
+      if (longer[i] != 0) {
         return false;
       }
     }
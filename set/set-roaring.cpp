@@ -0,0 +1,100 @@
+#include "headers/set-roaring.hpp"
+
+#include <iostream>
+#include <vector>
+
+int main() {
+  std::cout << "===== Testowanie klasy SetRoaring =====" << std::endl;
+
+  std::cout << "\n[Test 1] Dodawanie elementów... ";
+  SetRoaring s1;
+  s1.insert(0);
+  s1.insert(3);
+  s1.insert(4000000000u);
+  bool test1_ok = s1.contains(0) && s1.contains(3) && s1.contains(4000000000u) && !s1.contains(1) && s1.size() == 3;
+  std::cout << (test1_ok ? "PASSED" : "FAILED") << std::endl;
+
+  std::cout << "[Test 2] Usuwanie elementu... ";
+  s1.remove(3);
+  s1.remove(4000000000u);
+  bool test2_ok = !s1.contains(3) && !s1.contains(4000000000u) && s1.size() == 1;
+  std::cout << (test2_ok ? "PASSED" : "FAILED") << std::endl;
+
+  std::cout << "[Test 3] Gęsty fragment (bitmapa)... ";
+  SetRoaring dense;
+  for (uint32_t i = 0; i < 20000; i += 2) {
+    dense.insert(70000 + i);
+  }
+  bool test3_ok = dense.size() == 10000 && dense.contains(70000) && !dense.contains(70001) && dense.contains(89998);
+  for (uint32_t i = 0; i < 20000; i += 4) {
+    dense.remove(70000 + i);
+  }
+  test3_ok = test3_ok && dense.size() == 5000 && !dense.contains(70000) && dense.contains(70002);
+  std::cout << (test3_ok ? "PASSED" : "FAILED") << std::endl;
+
+  std::cout << "[Test 4] Ciągi kolejnych wartości (runy)... ";
+  SetRoaring runs;
+  for (uint32_t i = 0; i < 60000; i++) {
+    runs.insert(1u << 20 | i);
+  }
+  size_t before = runs.bytesUsed();
+  runs.runOptimize();
+  runs.remove(1u << 20 | 30000);
+  runs.insert(1u << 20 | 60000);
+  bool test4_ok = runs.bytesUsed() < before / 20 && runs.size() == 60000 && !runs.contains(1u << 20 | 30000) &&
+                  runs.contains(1u << 20 | 29999) && runs.contains(1u << 20 | 60000);
+  std::cout << (test4_ok ? "PASSED" : "FAILED") << std::endl;
+
+  std::cout << "[Test 5] Suma zbiorów... ";
+  SetRoaring A, B;
+  A.insert(1);
+  A.insert(5);
+  B.insert(2);
+  B.insert(1u << 31);
+  SetRoaring C = A + B;
+  bool test5_ok = C.contains(1) && C.contains(2) && C.contains(5) && C.contains(1u << 31) && C.size() == 4;
+  C = A + runs + dense;
+  test5_ok = test5_ok && C.size() == 2 + 60000 + 5000;
+  std::cout << (test5_ok ? "PASSED" : "FAILED") << std::endl;
+
+  std::cout << "[Test 6] Część wspólna... ";
+  A.insert(2);
+  SetRoaring D = A * B;
+  SetRoaring window;
+  for (uint32_t i = 29990; i < 30010; i++) {
+    window.insert(1u << 20 | i);
+  }
+  SetRoaring E = window * runs;
+  bool test6_ok = D.contains(2) && !D.contains(1) && D.size() == 1 && E.size() == 19 && !E.contains(1u << 20 | 30000);
+  std::cout << (test6_ok ? "PASSED" : "FAILED") << std::endl;
+
+  std::cout << "[Test 7] Różnica zbiorów... ";
+  SetRoaring F = A - B;
+  SetRoaring G = runs - window;
+  bool test7_ok = F.contains(1) && F.contains(5) && !F.contains(2) && G.size() == 60000 - 19 && G.contains(1u << 20);
+  std::cout << (test7_ok ? "PASSED" : "FAILED") << std::endl;
+
+  std::cout << "[Test 8] Porównywanie zbiorów... ";
+  SetRoaring X, Y;
+  for (uint32_t i = 0; i < 100; i++) {
+    X.insert(i);
+    Y.insert(i);
+  }
+  Y.runOptimize();
+  bool test8_ok = X == Y;
+  Y.insert(100);
+  test8_ok = test8_ok && !(X == Y);
+  std::cout << (test8_ok ? "PASSED" : "FAILED") << std::endl;
+
+  std::cout << "[Test 9] Elementy w kolejności... ";
+  SetRoaring Z;
+  Z.insert(1u << 31);
+  Z.insert(7);
+  Z.insert(65536);
+  std::vector<uint32_t> values = Z.toVector();
+  bool test9_ok = values.size() == 3 && values[0] == 7 && values[1] == 65536 && values[2] == (1u << 31);
+  std::cout << (test9_ok ? "PASSED" : "FAILED") << std::endl;
+
+  std::cout << "\n===== Koniec testów =====" << std::endl;
+  return 0;
+}
@@ -1,6 +1,7 @@
 #include "headers/set-simple.hpp"
 
 #include <iostream>
+#include <vector>
 
 int main() {
   std::cout << "===== Testowanie klasy SetSimple =====" << std::endl;
@@ -70,6 +71,44 @@ int main() {
   test9_ok = test9_ok && !s3.contains(0);
   std::cout << (test9_ok ? "PASSED" : "FAILED") << std::endl;
 
+  std::cout << "[Test 10] Operacje w miejscu... ";
+  SetSimple F(200), G(300);
+  F.insert(1);
+  F.insert(100);
+  G.insert(100);
+  G.insert(250);
+  SetSimple H = F;
+  H |= G;
+  bool test10_ok = H.contains(1) && H.contains(100) && H.contains(250);
+  H = F;
+  H &= G;
+  test10_ok = test10_ok && !H.contains(1) && H.contains(100) && !H.contains(250);
+  H = F;
+  H -= G;
+  test10_ok = test10_ok && H.contains(1) && !H.contains(100);
+  std::cout << (test10_ok ? "PASSED" : "FAILED") << std::endl;
+
+  std::cout << "[Test 11] Liczba elementów... ";
+  SetSimple K(1000);
+  for (int i = 0; i < 1000; i += 3) {
+    K.insert(i);
+  }
+  bool test11_ok = K.size() == 334 && SetSimple(10).size() == 0;
+  std::cout << (test11_ok ? "PASSED" : "FAILED") << std::endl;
+
+  std::cout << "[Test 12] Iteracja po elementach... ";
+  SetSimple L(200);
+  L.insert(199);
+  L.insert(0);
+  L.insert(64);
+  L.insert(63);
+  std::vector<int> visited(L.begin(), L.end());
+  int expected[] = {0, 63, 64, 199};
+  bool test12_ok = visited == std::vector<int>(expected, expected + 4);
+  SetSimple empty(200);
+  test12_ok = test12_ok && empty.begin() == empty.end();
+  std::cout << (test12_ok ? "PASSED" : "FAILED") << std::endl;
+
   std::cout << "\n===== Koniec testów =====" << std::endl;
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,331 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "benchmark_utils.h"
+#include "sorting_algorithms.h"
+#include "stable_sort.h"
+
+// Sorting benchmark suite. Every (algorithm, distribution, size) cell is run once as a warm-up
+// and then `repeats` times on a fresh copy of the same input generated from a fixed seed. Every
+// output, including the warm-up, is compared with std::sort's result before it is accepted.
+
+enum class Growth { NLogN, Quadratic };
+
+struct Algorithm {
+  std::string name;
+  std::function<void(std::vector<int>&)> sort;
+  Growth growth = Growth::NLogN;
+  // Distributions on which the algorithm degrades to quadratic time and O(n) recursion depth
+  std::vector<std::string> degenerateOn = {};
+};
+
+// Degenerate (algorithm, distribution) pairs are never run above this size, not even as the first
+// size: the recursion would overflow the stack long before the time budget applies.
+constexpr size_t DEGENERATE_MAX_SIZE = 20000;
+
+struct Distribution {
+  std::string name;
+  std::function<std::vector<int>(size_t, std::mt19937_64&)> generate;
+};
+
+struct Measurement {
+  std::string algorithm;
+  std::string distribution;
+  size_t size;
+  size_t repeats;
+  double medianNs;
+  double minNs;
+  double maxNs;
+  double stddevNs;
+  bool valid;
+};
+
+struct Options {
+  std::vector<size_t> sizes = {1000, 10000, 100000, 1000000};
+  size_t repeats = 5;
+  // A cell is skipped when the time extrapolated from the previous size, by the algorithm's growth
+  // rate, exceeds this budget.
+  double budgetSeconds = 1.0;
+  uint64_t seed = 42;
+  std::string csvPath = "data/sort_benchmark.csv";
+  std::string jsonPath = "data/sort_benchmark.json";
+  // Comma-separated name filters; empty runs everything.
+  std::string algorithms;
+  std::string distributions;
+};
+
+std::vector<Algorithm> makeAlgorithms() {
+  return {
+      {"BubbleSort", bubbleSort, Growth::Quadratic},
+      {"InsertionSort", insertionSort, Growth::Quadratic},
+      {"SelectionSort", selectionSort, Growth::Quadratic},
+      // Last-element pivot and a strict `<` partition: only random input avoids the worst case
+      {"QuickSort", [](std::vector<int>& arr) { quickSort(arr, 0, static_cast<int>(arr.size()) - 1); },
+       Growth::NLogN,
+       {"sorted", "reversed", "organ-pipe", "few-unique", "zipf", "sawtooth", "nearly-sorted"}},
+      {"HeapSort", heapSort},
+      {"BottomUpHeapSort", bottomUpHeapSort},
+      {"QuaternaryHeapSort", quaternaryHeapSort},
+      {"PowerSort", [](std::vector<int>& arr) { powersort::sort(arr.begin(), arr.end()); }},
+      {"StdSort", [](std::vector<int>& arr) { std::sort(arr.begin(), arr.end()); }},
+  };
+}
+
+std::vector<Distribution> makeDistributions() {
+  return {
+      {"random",
+       [](size_t n, std::mt19937_64& rng) {
+         std::uniform_int_distribution<int> dist(0, static_cast<int>(n));
+         std::vector<int> arr(n);
+         for (auto& value : arr) value = dist(rng);
+         return arr;
+       }},
+      {"sorted",
+       [](size_t n, std::mt19937_64&) {
+         std::vector<int> arr(n);
+         std::iota(arr.begin(), arr.end(), 0);
+         return arr;
+       }},
+      {"reversed",
+       [](size_t n, std::mt19937_64&) {
+         std::vector<int> arr(n);
+         std::iota(arr.rbegin(), arr.rend(), 0);
+         return arr;
+       }},
+      {"organ-pipe",
+       [](size_t n, std::mt19937_64&) {
+         std::vector<int> arr(n);
+         for (size_t i = 0; i < n; i++) arr[i] = static_cast<int>(std::min(i, n - 1 - i));
+         return arr;
+       }},
+      {"few-unique",
+       [](size_t n, std::mt19937_64& rng) {
+         std::uniform_int_distribution<int> dist(0, 15);
+         std::vector<int> arr(n);
+         for (auto& value : arr) value = dist(rng);
+         return arr;
+       }},
+      {"zipf",
+       [](size_t n, std::mt19937_64& rng) {
+         // Value k (1-based rank) is drawn with probability proportional to 1 / k^1.1.
+         std::vector<double> cdf(n);
+         double total = 0;
+         for (size_t k = 0; k < n; k++) {
+           total += 1.0 / std::pow(static_cast<double>(k + 1), 1.1);
+           cdf[k] = total;
+         }
+         std::uniform_real_distribution<double> dist(0, total);
+         std::vector<int> arr(n);
+         for (auto& value : arr) {
+           value = static_cast<int>(std::lower_bound(cdf.begin(), cdf.end(), dist(rng)) - cdf.begin());
+         }
+         return arr;
+       }},
+      {"sawtooth",
+       [](size_t n, std::mt19937_64&) {
+         size_t period = std::max<size_t>(1, n / 16);
+         std::vector<int> arr(n);
+         for (size_t i = 0; i < n; i++) arr[i] = static_cast<int>(i % period);
+         return arr;
+       }},
+      {"nearly-sorted",
+       [](size_t n, std::mt19937_64& rng) {
+         // Sorted input with 1% of the positions swapped with a random partner.
+         std::vector<int> arr(n);
+         std::iota(arr.begin(), arr.end(), 0);
+         std::uniform_int_distribution<size_t> dist(0, n - 1);
+         for (size_t swaps = n / 100; swaps > 0; swaps--) std::swap(arr[dist(rng)], arr[dist(rng)]);
+         return arr;
+       }},
+  };
+}
+
+Measurement measure(const Algorithm& algorithm, const Distribution& distribution, size_t size,
+                    const std::vector<int>& input, const std::vector<int>& expected, size_t repeats) {
+  bool valid = true;
+  auto runOnce = [&] {
+    std::vector<int> arr = input;
+    double ns = timeNs([&] { algorithm.sort(arr); });
+    valid = valid && arr == expected;
+    return ns;
+  };
+
+  runOnce();
+  std::vector<double> times;
+  for (size_t i = 0; i < repeats; i++) {
+    times.push_back(runOnce());
+  }
+  Summary s = summarize(times);
+
+  return {algorithm.name, distribution.name, size, repeats, s.median, s.min, s.max, s.stddev, valid};
+}
+
+void writeCsv(const std::string& path, const std::vector<Measurement>& results) {
+  std::ofstream out(path);
+  out << "algorithm,distribution,size,repeats,median_ns,min_ns,max_ns,stddev_ns,ns_per_element,valid\n";
+  for (const auto& r : results) {
+    out << r.algorithm << ',' << r.distribution << ',' << r.size << ',' << r.repeats << ',' << r.medianNs << ','
+        << r.minNs << ',' << r.maxNs << ',' << r.stddevNs << ',' << r.medianNs / r.size << ','
+        << (r.valid ? "true" : "false") << '\n';
+  }
+}
+
+void writeJson(const std::string& path, const std::vector<Measurement>& results, const Options& options) {
+  std::ofstream out(path);
+  out << "{\n";
+  out << "  \"timestamp\": " << std::time(nullptr) << ",\n";
+  out << "  \"compiler\": \"" << __VERSION__ << "\",\n";
+  out << "  \"seed\": " << options.seed << ",\n";
+  out << "  \"results\": [\n";
+  for (size_t i = 0; i < results.size(); i++) {
+    const auto& r = results[i];
+    out << "    {\"algorithm\": \"" << r.algorithm << "\", \"distribution\": \"" << r.distribution
+        << "\", \"size\": " << r.size << ", \"repeats\": " << r.repeats << ", \"median_ns\": " << r.medianNs
+        << ", \"min_ns\": " << r.minNs << ", \"max_ns\": " << r.maxNs << ", \"stddev_ns\": " << r.stddevNs
+        << ", \"ns_per_element\": " << r.medianNs / r.size << ", \"valid\": " << (r.valid ? "true" : "false")
+        << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+  }
+  out << "  ]\n}\n";
+}
+
+// Time for `size` elements predicted from `seconds` measured at `previousSize`
+double extrapolate(double seconds, size_t previousSize, size_t size, Growth growth) {
+  double scale = static_cast<double>(size) / previousSize;
+  if (growth == Growth::Quadratic) {
+    return seconds * scale * scale;
+  }
+  return seconds * scale * std::log2(static_cast<double>(size)) / std::log2(std::max<double>(previousSize, 2));
+}
+
+std::vector<std::string> splitList(const std::string& list) {
+  std::vector<std::string> items;
+  std::stringstream stream(list);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    items.push_back(item);
+  }
+  return items;
+}
+
+std::vector<size_t> parseSizes(const std::string& list) {
+  std::vector<size_t> sizes;
+  for (const auto& item : splitList(list)) {
+    sizes.push_back(std::stoull(item));
+  }
+  return sizes;
+}
+
+template <typename T>
+void applyFilter(std::vector<T>& entries, const std::string& filter) {
+  if (filter.empty()) {
+    return;
+  }
+  std::vector<std::string> names = splitList(filter);
+  entries.erase(std::remove_if(entries.begin(), entries.end(),
+                               [&](const T& entry) {
+                                 return std::find(names.begin(), names.end(), entry.name) == names.end();
+                               }),
+                entries.end());
+}
+
+Options parseOptions(int argc, char* argv[]) {
+  Options options;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string flag = argv[i];
+    std::string value = argv[i + 1];
+    if (flag == "--sizes") {
+      options.sizes = parseSizes(value);
+    } else if (flag == "--repeats") {
+      options.repeats = std::max<size_t>(1, std::stoull(value));
+    } else if (flag == "--budget") {
+      options.budgetSeconds = std::stod(value);
+    } else if (flag == "--seed") {
+      options.seed = std::stoull(value);
+    } else if (flag == "--csv") {
+      options.csvPath = value;
+    } else if (flag == "--json") {
+      options.jsonPath = value;
+    } else if (flag == "--algorithms") {
+      options.algorithms = value;
+    } else if (flag == "--distributions") {
+      options.distributions = value;
+    } else {
+      std::cerr << "Unknown option: " << flag << std::endl;
+    }
+  }
+  return options;
+}
+
+int main(int argc, char* argv[]) {
+  Options options = parseOptions(argc, argv);
+  std::sort(options.sizes.begin(), options.sizes.end());
+
+  std::vector<Algorithm> algorithms = makeAlgorithms();
+  std::vector<Distribution> distributions = makeDistributions();
+  applyFilter(algorithms, options.algorithms);
+  applyFilter(distributions, options.distributions);
+  std::vector<Measurement> results;
+  bool allValid = true;
+
+  for (size_t d = 0; d < distributions.size(); d++) {
+    const auto& distribution = distributions[d];
+    std::vector<double> lastSeconds(algorithms.size(), 0);
+    size_t previousSize = 0;
+
+    for (size_t size : options.sizes) {
+      std::mt19937_64 rng(options.seed + d * 1000003 + size);
+      std::vector<int> input = distribution.generate(size, rng);
+      std::vector<int> expected = input;
+      std::sort(expected.begin(), expected.end());
+
+      for (size_t a = 0; a < algorithms.size(); a++) {
+        const auto& algorithm = algorithms[a];
+        bool degenerate = std::find(algorithm.degenerateOn.begin(), algorithm.degenerateOn.end(),
+                                    distribution.name) != algorithm.degenerateOn.end();
+        if (degenerate && size > DEGENERATE_MAX_SIZE) {
+          lastSeconds[a] = -1;
+          std::cout << "Skipping " << algorithm.name << " / " << distribution.name << " / " << size
+                    << " (degenerate input, capped at " << DEGENERATE_MAX_SIZE << ")" << std::endl;
+          continue;
+        }
+        if (previousSize > 0) {
+          Growth growth = degenerate ? Growth::Quadratic : algorithm.growth;
+          if (lastSeconds[a] < 0 || extrapolate(lastSeconds[a], previousSize, size, growth) > options.budgetSeconds) {
+            lastSeconds[a] = -1;
+            std::cout << "Skipping " << algorithm.name << " / " << distribution.name << " / " << size
+                      << " (over time budget)" << std::endl;
+            continue;
+          }
+        }
+
+        Measurement m = measure(algorithm, distribution, size, input, expected, options.repeats);
+        lastSeconds[a] = m.medianNs / 1e9;
+        allValid = allValid && m.valid;
+        results.push_back(m);
+
+        std::cout << algorithm.name << " / " << distribution.name << " / " << size << ": " << m.medianNs / size
+                  << " ns/element (min " << m.minNs / size << ", max " << m.maxNs / size << ")"
+                  << (m.valid ? "" : " INVALID OUTPUT") << std::endl;
+      }
+      previousSize = size;
+    }
+  }
+
+  ensureParentDirectory(options.csvPath);
+  ensureParentDirectory(options.jsonPath);
+  writeCsv(options.csvPath, results);
+  writeJson(options.jsonPath, results, options);
+  std::cout << "Results saved to " << options.csvPath << " and " << options.jsonPath << std::endl;
+
+  return allValid ? 0 : 1;
+}
@@ -0,0 +1,48 @@
+#ifndef BENCHMARK_UTILS_H
+#define BENCHMARK_UTILS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <numeric>
+#include <string>
+#include <vector>
+
+// Helpers shared by the benchmark programs in this directory.
+
+struct Summary {
+  double median;
+  double min;
+  double max;
+  double stddev;
+};
+
+inline Summary summarize(std::vector<double> samples) {
+  std::sort(samples.begin(), samples.end());
+  size_t n = samples.size();
+
+  double median = n % 2 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+  double mean = std::accumulate(samples.begin(), samples.end(), 0.0) / n;
+  double variance = 0;
+  for (double sample : samples) variance += (sample - mean) * (sample - mean);
+
+  return {median, samples.front(), samples.back(), std::sqrt(variance / n)};
+}
+
+template <typename F>
+double timeNs(F&& f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+inline void ensureParentDirectory(const std::string& path) {
+  std::filesystem::path parent = std::filesystem::path(path).parent_path();
+  if (!parent.empty()) {
+    std::filesystem::create_directories(parent);
+  }
+}
+
+#endif  // BENCHMARK_UTILS_H
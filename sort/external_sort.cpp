@@ -0,0 +1,392 @@
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// External merge sort for binary files of native-endian 32-bit integers that are larger than RAM.
+//
+// Stage 1 reads the input in chunks as large as the memory budget, sorts every chunk in memory
+// and writes it out as a sorted run. Stage 2 merges up to `fanIn` runs at a time through a loser
+// tree. Every run reader and the output writer own two buffers, so the next block is read (or the
+// previous block is written) on a background thread while the loser tree works on the current one.
+
+using Key = int32_t;
+
+struct Config {
+  std::string inputPath;
+  std::string outputPath;
+  std::string tempDir;
+  size_t memoryBytes = size_t(256) << 20;
+  size_t fanIn = 64;
+};
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+double megabytesPerSecond(uint64_t bytes, double seconds) {
+  return seconds > 0 ? bytes / (1024.0 * 1024.0) / seconds : 0.0;
+}
+
+// Thin RAII wrapper over FILE*. stdio buffering is disabled because every caller already
+// transfers data in blocks of several megabytes.
+class BinaryFile {
+  FILE* file;
+  std::string path;
+
+ public:
+  BinaryFile(const std::string& filePath, const char* mode)
+      : file(std::fopen(filePath.c_str(), mode)), path(filePath) {
+    if (!file) {
+      throw std::runtime_error("Cannot open file: " + path);
+    }
+    std::setvbuf(file, nullptr, _IONBF, 0);
+  }
+
+  BinaryFile(const BinaryFile&) = delete;
+  BinaryFile& operator=(const BinaryFile&) = delete;
+
+  ~BinaryFile() {
+    std::fclose(file);
+  }
+
+  size_t read(Key* destination, size_t count) {
+    size_t result = std::fread(destination, sizeof(Key), count, file);
+    if (result < count && std::ferror(file)) {
+      throw std::runtime_error("Read error: " + path);
+    }
+    return result;
+  }
+
+  void write(const Key* source, size_t count) {
+    if (std::fwrite(source, sizeof(Key), count, file) != count) {
+      throw std::runtime_error("Write error: " + path);
+    }
+  }
+};
+
+// Sequential reader of one sorted run. While the merge consumes `current`, the following block
+// is already being read into `next` by an asynchronous task.
+class RunReader {
+  BinaryFile file;
+  std::vector<Key> current;
+  std::vector<Key> next;
+  size_t position = 0;
+  size_t available = 0;
+  std::future<size_t> pending;
+
+  void prefetch() {
+    pending = std::async(std::launch::async, [this] { return file.read(next.data(), next.size()); });
+  }
+
+  void refill() {
+    available = pending.get();
+    position = 0;
+    if (available == 0) {
+      return;
+    }
+    std::swap(current, next);
+    prefetch();
+  }
+
+ public:
+  RunReader(const std::string& path, size_t blockKeys)
+      : file(path, "rb"), current(blockKeys), next(blockKeys) {
+    available = file.read(current.data(), current.size());
+    if (available == current.size()) {
+      prefetch();
+    }
+  }
+
+  bool exhausted() const {
+    return position == available;
+  }
+
+  Key peek() const {
+    return current[position];
+  }
+
+  void advance() {
+    if (++position == available && pending.valid()) {
+      refill();
+    }
+  }
+};
+
+// Output counterpart of RunReader: a full buffer is handed to a background write while the
+// merge keeps filling the other one.
+class RunWriter {
+  BinaryFile file;
+  std::vector<Key> current;
+  std::vector<Key> flushing;
+  size_t count = 0;
+  std::future<void> pending;
+
+  void flush() {
+    if (pending.valid()) {
+      pending.get();
+    }
+    std::swap(current, flushing);
+    size_t size = count;
+    count = 0;
+    pending = std::async(std::launch::async, [this, size] { file.write(flushing.data(), size); });
+  }
+
+ public:
+  RunWriter(const std::string& path, size_t blockKeys)
+      : file(path, "wb"), current(blockKeys), flushing(blockKeys) {
+  }
+
+  void push(Key key) {
+    current[count++] = key;
+    if (count == current.size()) {
+      flush();
+    }
+  }
+
+  void finish() {
+    if (count > 0) {
+      flush();
+    }
+    if (pending.valid()) {
+      pending.get();
+    }
+  }
+};
+
+// Tournament tree of losers over k sorted readers. Leaves are the implicit positions k..2k-1,
+// internal node i stores the reader that lost the match played there and tree[0] stores the
+// overall winner, so replaying after the winner advances costs exactly one comparison per level.
+class LoserTree {
+  std::vector<RunReader*>& readers;
+  std::vector<size_t> tree;
+
+  // Exhausted readers lose every match, which avoids reserving a sentinel key value.
+  bool beats(size_t a, size_t b) const {
+    if (readers[a]->exhausted()) {
+      return false;
+    }
+    if (readers[b]->exhausted()) {
+      return true;
+    }
+    return readers[a]->peek() < readers[b]->peek();
+  }
+
+ public:
+  explicit LoserTree(std::vector<RunReader*>& sources)
+      : readers(sources), tree(sources.size(), 0) {
+    size_t k = readers.size();
+    std::vector<size_t> winner(2 * k);
+    for (size_t i = 0; i < k; ++i) {
+      winner[k + i] = i;
+    }
+    for (size_t node = k - 1; node >= 1; --node) {
+      size_t a = winner[2 * node];
+      size_t b = winner[2 * node + 1];
+      winner[node] = beats(a, b) ? a : b;
+      tree[node] = beats(a, b) ? b : a;
+    }
+    tree[0] = k > 1 ? winner[1] : 0;
+  }
+
+  bool empty() const {
+    return readers[tree[0]]->exhausted();
+  }
+
+  Key top() const {
+    return readers[tree[0]]->peek();
+  }
+
+  void pop() {
+    size_t winner = tree[0];
+    readers[winner]->advance();
+    for (size_t node = (winner + readers.size()) / 2; node > 0; node /= 2) {
+      if (beats(tree[node], winner)) {
+        std::swap(tree[node], winner);
+      }
+    }
+    tree[0] = winner;
+  }
+};
+
+class ExternalSorter {
+  Config config;
+  uint64_t inputBytes = 0;
+  size_t runCounter = 0;
+
+  std::string nextRunPath() {
+    std::filesystem::path path = config.tempDir;
+    path /= "extsort-" + std::to_string(getpid()) + "-" + std::to_string(runCounter++) + ".run";
+    return path.string();
+  }
+
+  std::vector<std::string> createRuns() {
+    std::vector<std::string> runs;
+    BinaryFile input(config.inputPath, "rb");
+    std::vector<Key> buffer(std::max<size_t>(1, config.memoryBytes / sizeof(Key)));
+
+    size_t count;
+    while ((count = input.read(buffer.data(), buffer.size())) > 0) {
+      inputBytes += count * sizeof(Key);
+      std::sort(buffer.begin(), buffer.begin() + count);
+
+      runs.push_back(nextRunPath());
+      BinaryFile run(runs.back(), "wb");
+      run.write(buffer.data(), count);
+    }
+    return runs;
+  }
+
+  // Each reader and the writer hold two blocks, so the budget is divided into 2 * (k + 1) blocks.
+  void mergeRuns(const std::vector<std::string>& runs, const std::string& outputPath) {
+    size_t blockKeys = std::max<size_t>(4096, config.memoryBytes / (2 * (runs.size() + 1)) / sizeof(Key));
+
+    std::vector<std::unique_ptr<RunReader>> storage;
+    std::vector<RunReader*> readers;
+    for (const auto& run : runs) {
+      storage.push_back(std::make_unique<RunReader>(run, blockKeys));
+      readers.push_back(storage.back().get());
+    }
+
+    RunWriter writer(outputPath, blockKeys);
+    if (!readers.empty()) {
+      LoserTree tree(readers);
+      while (!tree.empty()) {
+        writer.push(tree.top());
+        tree.pop();
+      }
+    }
+    writer.finish();
+  }
+
+ public:
+  explicit ExternalSorter(const Config& cfg)
+      : config(cfg) {
+  }
+
+  void run() {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::string> runs = createRuns();
+    double runSeconds = secondsSince(start);
+
+    std::cout << "Run formation: " << runs.size() << " runs, " << inputBytes / (1024.0 * 1024.0) << " MB in "
+              << runSeconds << " s (" << megabytesPerSecond(inputBytes, runSeconds) << " MB/s)" << std::endl;
+
+    auto mergeStart = std::chrono::steady_clock::now();
+    size_t passes = 1;
+    while (runs.size() > config.fanIn) {
+      std::vector<std::string> merged;
+      for (size_t first = 0; first < runs.size(); first += config.fanIn) {
+        size_t last = std::min(runs.size(), first + config.fanIn);
+        std::vector<std::string> group(runs.begin() + first, runs.begin() + last);
+        merged.push_back(nextRunPath());
+        mergeRuns(group, merged.back());
+        for (const auto& path : group) {
+          std::filesystem::remove(path);
+        }
+      }
+      runs.swap(merged);
+      ++passes;
+    }
+    mergeRuns(runs, config.outputPath);
+    for (const auto& path : runs) {
+      std::filesystem::remove(path);
+    }
+    double mergeSeconds = secondsSince(mergeStart);
+    double totalSeconds = secondsSince(start);
+
+    std::cout << "Merge: " << passes << " pass(es), fan-in " << config.fanIn << ", " << mergeSeconds << " s ("
+              << megabytesPerSecond(inputBytes * passes, mergeSeconds) << " MB/s)" << std::endl;
+    std::cout << "Total: " << totalSeconds << " s (" << megabytesPerSecond(inputBytes, totalSeconds) << " MB/s)"
+              << std::endl;
+  }
+};
+
+void generateInput(const std::string& path, uint64_t count, unsigned seed) {
+  std::mt19937 generator(seed);
+  std::uniform_int_distribution<Key> distribution;
+  RunWriter writer(path, size_t(1) << 20);
+  for (uint64_t i = 0; i < count; ++i) {
+    writer.push(distribution(generator));
+  }
+  writer.finish();
+}
+
+bool verifySorted(const std::string& path) {
+  RunReader reader(path, size_t(1) << 20);
+  if (reader.exhausted()) {
+    return true;
+  }
+  Key previous = reader.peek();
+  for (reader.advance(); !reader.exhausted(); reader.advance()) {
+    if (reader.peek() < previous) {
+      return false;
+    }
+    previous = reader.peek();
+  }
+  return true;
+}
+
+void printUsage(const char* program) {
+  std::cerr << "Usage:\n"
+            << "  " << program << " <input> <output> [--memory MB] [--tmp DIR] [--fan-in K]\n"
+            << "  " << program << " --generate <output> <count> [seed]\n"
+            << "  " << program << " --verify <file>\n";
+}
+
+int main(int argc, char* argv[]) {
+  try {
+    std::vector<std::string> args(argv + 1, argv + argc);
+
+    if (args.size() >= 3 && args[0] == "--generate") {
+      unsigned seed = args.size() >= 4 ? std::stoul(args[3]) : 12345;
+      generateInput(args[1], std::stoull(args[2]), seed);
+      return 0;
+    }
+    if (args.size() == 2 && args[0] == "--verify") {
+      bool sorted = verifySorted(args[1]);
+      std::cout << args[1] << (sorted ? " is sorted" : " is NOT sorted") << std::endl;
+      return sorted ? 0 : 1;
+    }
+
+    Config config;
+    std::vector<std::string> positional;
+    for (size_t i = 0; i < args.size(); ++i) {
+      if (args[i] == "--memory" && i + 1 < args.size()) {
+        config.memoryBytes = std::stoull(args[++i]) << 20;
+      } else if (args[i] == "--tmp" && i + 1 < args.size()) {
+        config.tempDir = args[++i];
+      } else if (args[i] == "--fan-in" && i + 1 < args.size()) {
+        config.fanIn = std::max<size_t>(2, std::stoull(args[++i]));
+      } else {
+        positional.push_back(args[i]);
+      }
+    }
+    if (positional.size() != 2 || config.memoryBytes == 0) {
+      printUsage(argv[0]);
+      return 1;
+    }
+    config.inputPath = positional[0];
+    config.outputPath = positional[1];
+    if (config.tempDir.empty()) {
+      config.tempDir = std::filesystem::temp_directory_path().string();
+    }
+
+    ExternalSorter sorter(config);
+    sorter.run();
+  } catch (const std::exception& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
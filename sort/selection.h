@@ -0,0 +1,195 @@
+#ifndef SELECTION_H
+#define SELECTION_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+
+// In-place, allocation-free selection: after a call the element at `nth` is the one that would be
+// there if [first, last) were sorted, everything before it is not greater and everything after it
+// is not less.
+//
+//   nthElement         introselect: median-of-3 quickselect that falls back to median-of-medians
+//                      pivots once it has used 2 * log2(n) partitioning rounds, so the worst case
+//                      stays linear.
+//   floydRivestSelect  Floyd-Rivest: recursively selects within a small sample around the expected
+//                      position of the k-th element, which leaves two tight pivots and touches
+//                      about n + min(k, n - k) elements on average.
+//   multiSelect        places many ranks (e.g. percentiles) in one recursive pass: select the middle
+//                      rank, then recurse on each side with only the ranks that fall there.
+
+namespace selection {
+
+namespace detail {
+
+constexpr std::ptrdiff_t INSERTION_THRESHOLD = 16;
+
+template <typename It, typename Compare>
+void insertionSort(It first, It last, Compare comp) {
+  for (It i = first + 1; i < last; ++i) {
+    for (It j = i; j > first && comp(*j, *(j - 1)); --j) {
+      std::iter_swap(j, j - 1);
+    }
+  }
+}
+
+// Hoare partition around *pivot. Scans stop on elements equal to the pivot, so inputs with many
+// duplicates still split near the middle. Returns the final position of the pivot.
+template <typename It, typename Compare>
+It partition(It first, It last, It pivot, Compare comp) {
+  std::iter_swap(first, pivot);
+  It i = first, j = last;
+  while (true) {
+    while (comp(*++i, *first)) {
+      if (i == last - 1) break;
+    }
+    while (comp(*first, *--j)) {
+      if (j == first) break;
+    }
+    if (i >= j) break;
+    std::iter_swap(i, j);
+  }
+  std::iter_swap(first, j);
+  return j;
+}
+
+template <typename It, typename Compare>
+It medianOfThree(It a, It b, It c, Compare comp) {
+  if (comp(*a, *b)) {
+    return comp(*b, *c) ? b : (comp(*a, *c) ? c : a);
+  }
+  return comp(*a, *c) ? a : (comp(*b, *c) ? c : b);
+}
+
+template <typename It, typename Compare>
+void introSelect(It first, It nth, It last, Compare comp, bool guaranteedLinear);
+
+// BFPRT pivot: medians of groups of five are gathered at the front of the range and their
+// median is selected recursively with the same guaranteed-linear routine.
+template <typename It, typename Compare>
+It medianOfMedians(It first, It last, Compare comp) {
+  std::ptrdiff_t n = last - first;
+  It medians = first;
+  for (std::ptrdiff_t group = 0; group + 5 <= n; group += 5) {
+    insertionSort(first + group, first + group + 5, comp);
+    std::iter_swap(medians++, first + group + 2);
+  }
+  introSelect(first, first + (medians - first) / 2, medians, comp, true);
+  return first + (medians - first) / 2;
+}
+
+template <typename It, typename Compare>
+void introSelect(It first, It nth, It last, Compare comp, bool guaranteedLinear) {
+  std::ptrdiff_t budget = 2 * static_cast<std::ptrdiff_t>(std::log2(std::max<std::ptrdiff_t>(2, last - first)));
+
+  while (last - first > INSERTION_THRESHOLD) {
+    It pivot;
+    if (guaranteedLinear || budget-- <= 0) {
+      pivot = medianOfMedians(first, last, comp);
+    } else {
+      pivot = medianOfThree(first, first + (last - first) / 2, last - 1, comp);
+    }
+
+    It split = partition(first, last, pivot, comp);
+    if (split == nth) {
+      return;
+    }
+    if (nth < split) {
+      last = split;
+    } else {
+      first = split + 1;
+    }
+  }
+  insertionSort(first, last, comp);
+}
+
+}  // namespace detail
+
+template <typename It, typename Compare = std::less<>>
+void nthElement(It first, It nth, It last, Compare comp = Compare()) {
+  if (first == last || nth == last) {
+    return;
+  }
+  detail::introSelect(first, nth, last, comp, false);
+}
+
+template <typename It, typename Compare = std::less<>>
+void floydRivestSelect(It first, It nth, It last, Compare comp = Compare()) {
+  if (first == last || nth == last) {
+    return;
+  }
+  std::ptrdiff_t left = 0, right = last - first - 1, k = nth - first;
+
+  while (right > left) {
+    if (right - left > 600) {
+      // Recurse on a sample of size s around k's expected position; sd widens it so the k-th
+      // element lands inside with high probability.
+      double n = static_cast<double>(right - left + 1);
+      double i = static_cast<double>(k - left + 1);
+      double z = std::log(n);
+      double s = 0.5 * std::exp(2 * z / 3);
+      double sd = 0.5 * std::sqrt(z * s * (n - s) / n) * (i - n / 2 < 0 ? -1 : 1);
+      std::ptrdiff_t newLeft = std::max(left, static_cast<std::ptrdiff_t>(k - i * s / n + sd));
+      std::ptrdiff_t newRight = std::min(right, static_cast<std::ptrdiff_t>(k + (n - i) * s / n + sd));
+      floydRivestSelect(first + newLeft, first + k, first + newRight + 1, comp);
+    }
+
+    // Partition around t = the current k-th element; t ends up at `left` or at `right`.
+    auto t = first[k];
+    std::ptrdiff_t i = left, j = right;
+    std::iter_swap(first + left, first + k);
+    if (comp(t, first[right])) {
+      std::iter_swap(first + right, first + left);
+    }
+    while (i < j) {
+      std::iter_swap(first + i, first + j);
+      ++i;
+      --j;
+      while (comp(first[i], t)) ++i;
+      while (comp(t, first[j])) --j;
+    }
+
+    if (!comp(first[left], t) && !comp(t, first[left])) {
+      std::iter_swap(first + left, first + j);
+    } else {
+      ++j;
+      std::iter_swap(first + j, first + right);
+    }
+
+    if (j <= k) left = j + 1;
+    if (k <= j) right = j - 1;
+  }
+}
+
+namespace detail {
+
+template <typename It, typename RankIt, typename Compare>
+void multiSelect(It first, It last, RankIt ranksFirst, RankIt ranksLast, Compare comp, std::ptrdiff_t offset) {
+  if (ranksFirst == ranksLast || first == last) {
+    return;
+  }
+  RankIt middle = ranksFirst + (ranksLast - ranksFirst) / 2;
+  It nth = first + (static_cast<std::ptrdiff_t>(*middle) - offset);
+  introSelect(first, nth, last, comp, false);
+
+  // Ranks equal to the middle one are already in place.
+  RankIt leftEnd = std::lower_bound(ranksFirst, middle, *middle);
+  RankIt rightBegin = std::upper_bound(middle, ranksLast, *middle);
+  multiSelect(first, nth, ranksFirst, leftEnd, comp, offset);
+  multiSelect(nth + 1, last, rightBegin, ranksLast, comp, offset + (nth + 1 - first));
+}
+
+}  // namespace detail
+
+// Places every rank in [ranksFirst, ranksLast) (sorted ascending, each < last - first) as
+// nthElement would, sharing the partitioning work between neighbouring ranks.
+template <typename It, typename RankIt, typename Compare = std::less<>>
+void multiSelect(It first, It last, RankIt ranksFirst, RankIt ranksLast, Compare comp = Compare()) {
+  detail::multiSelect(first, last, ranksFirst, ranksLast, comp, 0);
+}
+
+}  // namespace selection
+
+#endif  // SELECTION_H
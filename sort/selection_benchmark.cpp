@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark_utils.h"
+#include "selection.h"
+
+// Median and percentile extraction: selection.h against std::nth_element (and a full std::sort
+// for the percentile case). Every selected value is checked against the sorted input.
+
+struct Input {
+  std::string name;
+  std::function<std::vector<int>(size_t, std::mt19937_64&)> generate;
+};
+
+struct Contender {
+  std::string task;
+  std::string name;
+  std::function<void(std::vector<int>&, const std::vector<size_t>&)> select;
+};
+
+std::vector<Input> makeInputs() {
+  return {
+      {"random",
+       [](size_t n, std::mt19937_64& rng) {
+         std::vector<int> v(n);
+         for (auto& x : v) x = static_cast<int>(rng() >> 33);
+         return v;
+       }},
+      {"sorted",
+       [](size_t n, std::mt19937_64&) {
+         std::vector<int> v(n);
+         std::iota(v.begin(), v.end(), 0);
+         return v;
+       }},
+      {"few-unique",
+       [](size_t n, std::mt19937_64& rng) {
+         std::vector<int> v(n);
+         for (auto& x : v) x = static_cast<int>(rng() % 16);
+         return v;
+       }},
+      {"organ-pipe",
+       [](size_t n, std::mt19937_64&) {
+         std::vector<int> v(n);
+         for (size_t i = 0; i < n; i++) v[i] = static_cast<int>(std::min(i, n - 1 - i));
+         return v;
+       }},
+  };
+}
+
+std::vector<Contender> makeContenders() {
+  auto median = [](std::vector<int>& v, const std::vector<size_t>&) { return v.begin() + v.size() / 2; };
+  return {
+      {"median", "std::nth_element",
+       [=](std::vector<int>& v, const std::vector<size_t>& r) { std::nth_element(v.begin(), median(v, r), v.end()); }},
+      {"median", "nthElement",
+       [=](std::vector<int>& v, const std::vector<size_t>& r) {
+         selection::nthElement(v.begin(), median(v, r), v.end());
+       }},
+      {"median", "floydRivestSelect",
+       [=](std::vector<int>& v, const std::vector<size_t>& r) {
+         selection::floydRivestSelect(v.begin(), median(v, r), v.end());
+       }},
+      {"percentiles", "std::sort", [](std::vector<int>& v, const std::vector<size_t>&) { std::sort(v.begin(), v.end()); }},
+      {"percentiles", "repeated std::nth_element",
+       [](std::vector<int>& v, const std::vector<size_t>& ranks) {
+         for (size_t rank : ranks) std::nth_element(v.begin(), v.begin() + rank, v.end());
+       }},
+      {"percentiles", "multiSelect",
+       [](std::vector<int>& v, const std::vector<size_t>& ranks) {
+         selection::multiSelect(v.begin(), v.end(), ranks.begin(), ranks.end());
+       }},
+  };
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<size_t> sizes = {1000000, 10000000};
+  size_t repeats = argc > 1 ? std::stoul(argv[1]) : 5;
+  std::string csvPath = "data/selection_benchmark.csv";
+  const std::vector<double> percentiles = {0.01, 0.05, 0.10, 0.25, 0.50, 0.75, 0.90, 0.95, 0.99};
+
+  ensureParentDirectory(csvPath);
+  std::ofstream csv(csvPath);
+  csv << "task,input,size,algorithm,median_ns,min_ns,max_ns,stddev_ns,ns_per_element,valid\n";
+  bool allValid = true;
+
+  for (const auto& input : makeInputs()) {
+    for (size_t size : sizes) {
+      std::mt19937_64 rng(99 + size);
+      std::vector<int> data = input.generate(size, rng);
+      std::vector<int> sorted = data;
+      std::sort(sorted.begin(), sorted.end());
+
+      for (const auto& contender : makeContenders()) {
+        std::vector<size_t> ranks;
+        if (contender.task == "median") {
+          ranks.push_back(size / 2);
+        } else {
+          for (double p : percentiles) ranks.push_back(static_cast<size_t>(p * (size - 1)));
+        }
+
+        bool valid = true;
+        std::vector<double> times;
+        for (size_t i = 0; i <= repeats; i++) {
+          std::vector<int> v = data;
+          double ns = timeNs([&] { contender.select(v, ranks); });
+          for (size_t rank : ranks) valid = valid && v[rank] == sorted[rank];
+          if (i > 0) times.push_back(ns);
+        }
+        Summary s = summarize(times);
+        allValid = allValid && valid;
+
+        std::cout << contender.task << " / " << input.name << " / " << size << " / " << contender.name << ": "
+                  << s.median / 1e6 << " ms" << (valid ? "" : " INVALID OUTPUT") << std::endl;
+        csv << contender.task << ',' << input.name << ',' << size << ',' << contender.name << ',' << s.median << ','
+            << s.min << ',' << s.max << ',' << s.stddev << ',' << s.median / size << ',' << (valid ? "true" : "false")
+            << '\n';
+      }
+    }
+  }
+
+  std::cout << "Results saved to " << csvPath << std::endl;
+  return allValid ? 0 : 1;
+}
@@ -1,7 +1,7 @@
-#include <chrono>
-#include <cstdlib>
-#include <fstream>
-#include <iostream>
+#include "sorting_algorithms.h"
+
+#include <algorithm>
+#include <cstddef>
 #include <vector>
 
 // Function to swap two elements by reference
@@ -127,50 +127,87 @@ void heapSort(std::vector<int>& arr) {
   }
 }
 
-int main() {
-  std::vector<int> sizes = {10000, 25000, 50000, 100000};
-  std::vector<std::string> algorithms = {"BubbleSort", "InsertionSort", "QuickSort", "SelectionSort", "HeapSort"};
-
-  std::ofstream dataFile("benchmark_data.dat");
-  if (!dataFile.is_open()) {
-    std::cerr << "Nie udało się otworzyć pliku benchmark_data.dat do zapisu." << std::endl;
-    return 1;
-  }
-
-  for (const auto& algo : algorithms) {
-    dataFile << algo;
-
-    for (int size : sizes) {
-      std::vector<int> arr(size);
-      for (int i = 0; i < size; i++) {
-        arr[i] = rand() % size;
+// Sift-down used by the bottom-up heap sorts (Wegener's variant). The element being sifted is kept
+// out of the array, so every level moves one element instead of swapping two.
+template <size_t Arity>
+static void siftDownBottomUp(int* heap, size_t n, size_t hole, int value) {
+  size_t start = hole;
+
+  // Walk down to a leaf, pulling the largest child up into the hole. The sifted value is not
+  // compared on the way down, since it almost always belongs near the bottom anyway.
+  size_t child = Arity * hole + 1;
+  while (child + Arity <= n) {
+    size_t grandchild = Arity * child + 1;
+    if (grandchild < n)
+      __builtin_prefetch(&heap[grandchild]);  // Grandchildren of the first child
+    if (Arity > 2 && grandchild + Arity * Arity <= n)
+      __builtin_prefetch(&heap[grandchild + Arity * Arity - 1]);  // ... and of the last one
+
+    // Track the largest child's value in a register as well as its index; re-reading it through
+    // `heap` after the store below would force a reload on every level.
+    size_t largest = child;
+    int largestValue = heap[child];
+    if constexpr (Arity == 2) {
+      int right = heap[child + 1];
+      largest += right > largestValue;  // Index arithmetic keeps this free of branches
+      largestValue = std::max(largestValue, right);
+    } else {
+      for (size_t c = child + 1; c < child + Arity; c++) {
+        int candidate = heap[c];
+        bool greater = candidate > largestValue;
+        largest = greater ? c : largest;
+        largestValue = greater ? candidate : largestValue;
       }
-      auto arr_copy = arr;
-
-      auto start = std::chrono::high_resolution_clock::now();
-
-      if (algo == "BubbleSort")
-        bubbleSort(arr_copy);
-      else if (algo == "InsertionSort")
-        insertionSort(arr_copy);
-      else if (algo == "QuickSort")
-        quickSort(arr_copy, 0, size - 1);
-      else if (algo == "SelectionSort")
-        selectionSort(arr_copy);
-      else if (algo == "HeapSort")
-        heapSort(arr_copy);
+    }
 
-      auto end = std::chrono::high_resolution_clock::now();
-      auto time = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    heap[hole] = largestValue;  // Move the largest child up into the hole
+    hole = largest;
+    child = Arity * hole + 1;
+  }
+  if (child < n) {  // Last internal node with fewer than Arity children
+    size_t largest = child;
+    for (size_t c = child + 1; c < n; c++)
+      largest = heap[c] > heap[largest] ? c : largest;
+    heap[hole] = heap[largest];
+    hole = largest;
+  }
 
-      dataFile << " " << time;
-    }
-    dataFile << "\n";
+  // Climb back up from the leaf until the parent is not smaller than the sifted value
+  while (hole > start) {
+    size_t parent = (hole - 1) / Arity;
+    if (!(heap[parent] < value))
+      break;
+    heap[hole] = heap[parent];
+    hole = parent;
   }
+  heap[hole] = value;  // Drop the value into its final position
+}
 
-  dataFile.close();
+template <size_t Arity>
+static void heapSortBottomUp(std::vector<int>& arr) {
+  size_t length = arr.size();
+  if (length < 2)
+    return;
+  int* heap = arr.data();
+
+  // Build max heap from the last internal node upwards
+  for (size_t i = (length - 2) / Arity + 1; i-- > 0;)
+    siftDownBottomUp<Arity>(heap, length, i, heap[i]);
+
+  // Move the root to the end and sift the displaced last element into the reduced heap
+  for (size_t end = length - 1; end > 0; end--) {
+    int value = heap[end];
+    heap[end] = heap[0];
+    siftDownBottomUp<Arity>(heap, end, 0, value);
+  }
+}
 
-  system("gnuplot plot_script.gp");
+// Function implementing bottom-up Heap Sort on a binary heap
+void bottomUpHeapSort(std::vector<int>& arr) {
+  heapSortBottomUp<2>(arr);
+}
 
-  return 0;
+// Function implementing bottom-up Heap Sort on a 4-ary heap (half the levels, three comparisons per level)
+void quaternaryHeapSort(std::vector<int>& arr) {
+  heapSortBottomUp<4>(arr);
 }
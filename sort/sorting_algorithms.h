@@ -0,0 +1,21 @@
+#ifndef SORTING_ALGORITHMS_H
+#define SORTING_ALGORITHMS_H
+
+#include <vector>
+
+void swap(int* a, int* b);
+
+void bubbleSort(std::vector<int>& arr);
+void insertionSort(std::vector<int>& arr);
+
+int partition(std::vector<int>& arr, int low, int high);
+void quickSort(std::vector<int>& arr, int low, int high);
+
+void selectionSort(std::vector<int>& arr);
+
+void heapify(std::vector<int>& arr, int n, int i);
+void heapSort(std::vector<int>& arr);
+void bottomUpHeapSort(std::vector<int>& arr);
+void quaternaryHeapSort(std::vector<int>& arr);
+
+#endif  // SORTING_ALGORITHMS_H
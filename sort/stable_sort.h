@@ -0,0 +1,265 @@
+#ifndef STABLE_SORT_H
+#define STABLE_SORT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+// Adaptive stable merge sort for records (powersort, Munro & Wild 2018).
+//
+// The input is split into natural runs (strictly descending runs are reversed in place, short runs
+// are extended to MIN_RUN with binary insertion sort). Runs are merged following powersort's
+// nearly-optimal merge policy: each boundary between two runs gets a "power" derived from the
+// midpoints of the runs, and runs on the stack are merged while their power exceeds the new one.
+// Merges are TimSort-style: both ends are trimmed by galloping first, the smaller side is copied
+// into a scratch buffer that is kept between calls, and long winning streaks switch to galloping.
+//
+//   powersort::sort(records.begin(), records.end(), &Record::timestamp);
+//   powersort::sort(v.begin(), v.end(), [](const Row& r) { return r.name; }, std::greater<>());
+
+namespace powersort {
+
+struct Identity {
+  template <typename T>
+  const T& operator()(const T& value) const {
+    return value;
+  }
+};
+
+template <typename T>
+class Sorter {
+  static constexpr std::ptrdiff_t MIN_RUN = 32;
+  static constexpr std::ptrdiff_t MIN_GALLOP = 7;
+
+  struct Run {
+    std::ptrdiff_t begin;
+    std::ptrdiff_t end;
+    unsigned power;
+  };
+
+  std::vector<T> scratch;
+  std::vector<Run> runs;
+  std::ptrdiff_t minGallop = MIN_GALLOP;
+
+  // Finds the first element in [first, last) for which pred is false, assuming a true prefix.
+  // Probes positions 0, 1, 3, 7, ... before the binary search, so short prefixes are cheap.
+  template <typename It, typename Pred>
+  static It gallopFront(It first, It last, Pred pred) {
+    std::ptrdiff_t n = last - first, lo = 0, hi = 0;
+    while (hi < n && pred(first[hi])) {
+      lo = hi + 1;
+      hi = 2 * hi + 1;
+    }
+    return std::partition_point(first + lo, first + std::min(hi, n), pred);
+  }
+
+  // Mirror image of gallopFront: returns the start of the suffix of [first, last) for which pred holds.
+  template <typename It, typename Pred>
+  static It gallopBack(It first, It last, Pred pred) {
+    std::ptrdiff_t n = last - first, lo = 0, hi = 0;
+    while (hi < n && pred(last[-1 - hi])) {
+      lo = hi + 1;
+      hi = 2 * hi + 1;
+    }
+    return std::partition_point(last - std::min(hi, n), last - lo, [&](const T& x) { return !pred(x); });
+  }
+
+  // Power of the boundary between runs [s1, s1 + n1) and [s1 + n1, s1 + n1 + n2) in an array of
+  // length n: the number of leading bits shared by the two run midpoints, scaled to [0, 1).
+  static unsigned nodePower(std::ptrdiff_t s1, std::ptrdiff_t n1, std::ptrdiff_t n2, std::ptrdiff_t n) {
+    std::ptrdiff_t a = 2 * s1 + n1;
+    std::ptrdiff_t b = a + n1 + n2;
+    unsigned power = 0;
+    while (true) {
+      ++power;
+      if (a >= n) {
+        a -= n;
+        b -= n;
+      } else if (b >= n) {
+        break;
+      }
+      a <<= 1;
+      b <<= 1;
+    }
+    return power;
+  }
+
+  template <typename It, typename Less>
+  It extendRun(It first, It last, Less less) {
+    It next = first + 1;
+    if (next == last) {
+      return last;
+    }
+    if (less(*next, *first)) {
+      while (next + 1 != last && less(*(next + 1), *next)) ++next;
+      std::reverse(first, ++next);
+    } else {
+      while (next + 1 != last && !less(*(next + 1), *next)) ++next;
+      ++next;
+    }
+
+    It runEnd = first + std::min(MIN_RUN, last - first);
+    for (; next < runEnd; ++next) {
+      It position = std::upper_bound(first, next, *next, less);
+      std::rotate(position, next, next + 1);
+    }
+    return next;
+  }
+
+  // Merge with [first, mid) no longer than [mid, last): the left run goes to scratch and the
+  // output is written front to back.
+  template <typename It, typename Less>
+  void mergeLow(It first, It mid, It last, Less less) {
+    scratch.assign(std::make_move_iterator(first), std::make_move_iterator(mid));
+    auto a = scratch.begin(), aEnd = scratch.end();
+    It b = mid, out = first;
+
+    while (a != aEnd && b != last) {
+      std::ptrdiff_t countA = 0, countB = 0;
+      while (a != aEnd && b != last && std::max(countA, countB) < minGallop) {
+        if (less(*b, *a)) {
+          *out++ = std::move(*b++);
+          ++countB;
+          countA = 0;
+        } else {
+          *out++ = std::move(*a++);
+          ++countA;
+          countB = 0;
+        }
+      }
+
+      if (a == aEnd || b == last) break;
+
+      do {
+        auto aStop = gallopFront(a, aEnd, [&](const T& x) { return !less(*b, x); });
+        countA = aStop - a;
+        out = std::move(a, aStop, out);
+        a = aStop;
+        if (a == aEnd) break;
+        *out++ = std::move(*b++);
+        if (b == last) break;
+
+        It bStop = gallopFront(b, last, [&](const T& x) { return less(x, *a); });
+        countB = bStop - b;
+        out = std::move(b, bStop, out);
+        b = bStop;
+        if (b == last) break;
+        *out++ = std::move(*a++);
+        minGallop = std::max<std::ptrdiff_t>(1, minGallop - 1);
+      } while (countA >= MIN_GALLOP || countB >= MIN_GALLOP);
+      ++minGallop;
+    }
+    std::move(a, aEnd, out);
+  }
+
+  // Merge with [mid, last) shorter than [first, mid): the right run goes to scratch and the
+  // output is written back to front.
+  template <typename It, typename Less>
+  void mergeHigh(It first, It mid, It last, Less less) {
+    scratch.assign(std::make_move_iterator(mid), std::make_move_iterator(last));
+    auto bBegin = scratch.begin(), b = scratch.end();
+    It a = mid, out = last;
+
+    while (a != first && b != bBegin) {
+      std::ptrdiff_t countA = 0, countB = 0;
+      while (a != first && b != bBegin && std::max(countA, countB) < minGallop) {
+        if (less(*(b - 1), *(a - 1))) {
+          *--out = std::move(*--a);
+          ++countA;
+          countB = 0;
+        } else {
+          *--out = std::move(*--b);
+          ++countB;
+          countA = 0;
+        }
+      }
+
+      if (a == first || b == bBegin) break;
+
+      do {
+        It aStop = gallopBack(first, a, [&](const T& x) { return less(*(b - 1), x); });
+        countA = a - aStop;
+        out = std::move_backward(aStop, a, out);
+        a = aStop;
+        if (a == first) break;
+        *--out = std::move(*--b);
+        if (b == bBegin) break;
+
+        auto bStop = gallopBack(bBegin, b, [&](const T& x) { return !less(x, *(a - 1)); });
+        countB = b - bStop;
+        out = std::move_backward(bStop, b, out);
+        b = bStop;
+        if (b == bBegin) break;
+        *--out = std::move(*--a);
+        minGallop = std::max<std::ptrdiff_t>(1, minGallop - 1);
+      } while (countA >= MIN_GALLOP || countB >= MIN_GALLOP);
+      ++minGallop;
+    }
+    std::move_backward(bBegin, b, out);
+  }
+
+  template <typename It, typename Less>
+  void merge(It first, It mid, It last, Less less) {
+    // Elements of the left run not greater than the right run's head, and elements of the right
+    // run not less than the left run's tail, are already in their final positions.
+    first = gallopFront(first, mid, [&](const T& x) { return !less(*mid, x); });
+    if (first == mid) {
+      return;
+    }
+    last = gallopBack(mid, last, [&](const T& x) { return !less(x, *(mid - 1)); });
+
+    if (mid - first <= last - mid) {
+      mergeLow(first, mid, last, less);
+    } else {
+      mergeHigh(first, mid, last, less);
+    }
+  }
+
+ public:
+  template <typename It, typename Key = Identity, typename Compare = std::less<>>
+  void sort(It first, It last, Key key = Key(), Compare comp = Compare()) {
+    std::ptrdiff_t n = last - first;
+    if (n < 2) {
+      return;
+    }
+    auto less = [&](const T& x, const T& y) { return comp(std::invoke(key, x), std::invoke(key, y)); };
+
+    runs.clear();
+    minGallop = MIN_GALLOP;
+    std::ptrdiff_t begin1 = 0;
+    std::ptrdiff_t end1 = extendRun(first, last, less) - first;
+
+    while (end1 < n) {
+      std::ptrdiff_t end2 = extendRun(first + end1, last, less) - first;
+      unsigned power = nodePower(begin1, end1 - begin1, end2 - end1, n);
+
+      while (!runs.empty() && runs.back().power > power) {
+        merge(first + runs.back().begin, first + runs.back().end, first + end1, less);
+        begin1 = runs.back().begin;
+        runs.pop_back();
+      }
+      runs.push_back({begin1, end1, power});
+      begin1 = end1;
+      end1 = end2;
+    }
+
+    while (!runs.empty()) {
+      merge(first + runs.back().begin, first + runs.back().end, first + end1, less);
+      runs.pop_back();
+    }
+  }
+};
+
+// Convenience entry point; the scratch buffer and run stack persist per thread and element type.
+template <typename It, typename Key = Identity, typename Compare = std::less<>>
+void sort(It first, It last, Key key = Key(), Compare comp = Compare()) {
+  thread_local Sorter<typename std::iterator_traits<It>::value_type> sorter;
+  sorter.sort(first, last, key, comp);
+}
+
+}  // namespace powersort
+
+#endif  // STABLE_SORT_H
@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark_utils.h"
+#include "stable_sort.h"
+
+// Compares powersort::Sorter with std::stable_sort on 64-byte records keyed by timestamp. The
+// streams model data that arrives mostly in order: k interleaved-then-concatenated sorted sources,
+// an append log with late arrivals, and a fully random control. Every result must match
+// std::stable_sort exactly, which also verifies stability through the `sequence` field.
+
+struct Record {
+  uint32_t timestamp;
+  uint32_t sequence;
+  uint64_t id;
+  char payload[48];
+};
+
+struct Stream {
+  std::string name;
+  std::function<std::vector<Record>(size_t, std::mt19937_64&)> generate;
+};
+
+std::vector<Record> makeRecords(const std::vector<uint32_t>& timestamps) {
+  std::vector<Record> records(timestamps.size());
+  for (size_t i = 0; i < records.size(); i++) {
+    records[i].timestamp = timestamps[i];
+    records[i].sequence = static_cast<uint32_t>(i);
+    records[i].id = i * 2654435761u;
+  }
+  return records;
+}
+
+Stream concatenatedRuns(size_t runs) {
+  return {"runs-" + std::to_string(runs), [runs](size_t n, std::mt19937_64& rng) {
+            std::uniform_int_distribution<uint32_t> dist(0, static_cast<uint32_t>(n / 4));
+            std::vector<uint32_t> timestamps(n);
+            for (auto& t : timestamps) t = dist(rng);
+            for (size_t r = 0; r < runs; r++) {
+              std::sort(timestamps.begin() + r * n / runs, timestamps.begin() + (r + 1) * n / runs);
+            }
+            return makeRecords(timestamps);
+          }};
+}
+
+std::vector<Stream> makeStreams() {
+  return {
+      concatenatedRuns(4),
+      concatenatedRuns(64),
+      concatenatedRuns(1024),
+      {"late-arrivals",
+       [](size_t n, std::mt19937_64& rng) {
+         // Ordered by arrival; 5% of the events carry a timestamp up to 1000 ticks in the past.
+         std::uniform_int_distribution<uint32_t> delay(0, 1000);
+         std::bernoulli_distribution late(0.05);
+         std::vector<uint32_t> timestamps(n);
+         for (size_t i = 0; i < n; i++) {
+           uint32_t now = static_cast<uint32_t>(i) + 1000;
+           timestamps[i] = late(rng) ? now - delay(rng) : now;
+         }
+         return makeRecords(timestamps);
+       }},
+      {"random",
+       [](size_t n, std::mt19937_64& rng) {
+         std::uniform_int_distribution<uint32_t> dist(0, static_cast<uint32_t>(n / 4));
+         std::vector<uint32_t> timestamps(n);
+         for (auto& t : timestamps) t = dist(rng);
+         return makeRecords(timestamps);
+       }},
+  };
+}
+
+bool sameOrder(const std::vector<Record>& a, const std::vector<Record>& b) {
+  return std::equal(a.begin(), a.end(), b.begin(), [](const Record& x, const Record& y) {
+    return x.timestamp == y.timestamp && x.sequence == y.sequence;
+  });
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<size_t> sizes = {100000, 1000000};
+  size_t repeats = argc > 1 ? std::stoul(argv[1]) : 5;
+  std::string csvPath = "data/stable_sort_benchmark.csv";
+
+  ensureParentDirectory(csvPath);
+  std::ofstream csv(csvPath);
+  csv << "stream,size,algorithm,median_ns,min_ns,max_ns,stddev_ns,ns_per_element,valid\n";
+
+  powersort::Sorter<Record> sorter;
+  auto byTimestamp = [](const Record& a, const Record& b) { return a.timestamp < b.timestamp; };
+  bool allValid = true;
+
+  for (const auto& stream : makeStreams()) {
+    for (size_t size : sizes) {
+      std::mt19937_64 rng(1234 + size);
+      std::vector<Record> input = stream.generate(size, rng);
+      std::vector<Record> expected = input;
+      std::stable_sort(expected.begin(), expected.end(), byTimestamp);
+
+      std::vector<std::pair<std::string, std::function<void(std::vector<Record>&)>>> contenders = {
+          {"std::stable_sort",
+           [&](std::vector<Record>& v) { std::stable_sort(v.begin(), v.end(), byTimestamp); }},
+          {"powersort", [&](std::vector<Record>& v) { sorter.sort(v.begin(), v.end(), &Record::timestamp); }},
+      };
+
+      for (const auto& [name, sort] : contenders) {
+        bool valid = true;
+        std::vector<double> times;
+        for (size_t i = 0; i <= repeats; i++) {
+          std::vector<Record> records = input;
+          double ns = timeNs([&] { sort(records); });
+          valid = valid && sameOrder(records, expected);
+          if (i > 0) times.push_back(ns);
+        }
+        Summary s = summarize(times);
+        allValid = allValid && valid;
+
+        std::cout << stream.name << " / " << size << " / " << name << ": " << s.median / size << " ns/element"
+                  << (valid ? "" : " INVALID OUTPUT") << std::endl;
+        csv << stream.name << ',' << size << ',' << name << ',' << s.median << ',' << s.min << ',' << s.max << ','
+            << s.stddev << ',' << s.median / size << ',' << (valid ? "true" : "false") << '\n';
+      }
+    }
+  }
+
+  std::cout << "Results saved to " << csvPath << std::endl;
+  return allValid ? 0 : 1;
+}
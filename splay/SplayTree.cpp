@@ -1,219 +1,15 @@
 #include <iostream>
-#include <string>
-#include <vector>
 
-#include "TreePrinter.h"
-
-class SplayTree {
-  Node* root;
-
- private:
-  Node* rotateLeft(Node* node) {
-    if (!node || !node->right) {
-      return node;
-    }
-
-    Node* temp = node->right;
-    node->right = temp->left;
-    temp->left = node;
-    return temp;
-  }
-
-  Node* rotateRight(Node* node) {
-    if (!node || !node->left) {
-      return node;
-    }
-
-    Node* temp = node->left;
-    node->left = temp->right;
-    temp->right = node;
-    return temp;
-  }
-
-  Node* splay(int value, Node* node) {
-    if (!node || node->value == value) {
-      return node;
-    }
-
-    if (value < node->value) {
-      if (!node->left) {
-        return node;
-      }
-
-      if (value < node->left->value) {
-        // Zig-Zig case
-        node->left->left = splay(value, node->left->left);
-        node = rotateRight(node);
-      } else if (value > node->left->value) {
-        // Zig-Zag case
-        node->left->right = splay(value, node->left->right);
-        if (node->left->right) {
-          node->left = rotateLeft(node->left);
-        }
-      }
-
-      if (node->left) {
-        // Zig case
-        node = rotateRight(node);
-      }
-    } else {
-      if (!node->right) {
-        return node;
-      }
-
-      if (value > node->right->value) {
-        // Zag-Zag case
-        node->right->right = splay(value, node->right->right);
-        node = rotateLeft(node);
-      } else if (value < node->right->value) {
-        // Zag-Zig case
-        node->right->left = splay(value, node->right->left);
-        if (node->right->left) {
-          node->right = rotateRight(node->right);
-        }
-      }
-
-      if (node->right) {
-        // Zag case
-        node = rotateLeft(node);
-      }
-    }
-
-    return node;
-  }
-
-  void insert(int value, Node*& node) {
-    if (!node) {
-      node = new Node(value);
-      return;
-    }
-
-    node = splay(value, node);
-
-    if (value < node->value) {
-      insert(value, node->left);
-    } else if (value > node->value) {
-      insert(value, node->right);
-    }
-  }
-
-  bool contains(int value, Node* node) const {
-    if (!node) {
-      return false;
-    }
-    if (node->value == value) {
-      return true;
-    }
-    if (value < node->value) {
-      return contains(value, node->left);
-    }
-    return contains(value, node->right);
-  }
-
-  Node*& findMin(Node*& node) {
-    if (!node->left) {
-      return node;
-    }
-    return findMin(node->left);
-  }
-
-  Node* find(int value, Node*& node) {
-    if (!node || node->value == value) {
-      if (node) {
-        return new Node(node->value);
-      }
-      return nullptr;
-    }
-
-    Node* result = nullptr;
-    if (value < node->value) {
-      result = find(value, node->left);
-    } else {
-      result = find(value, node->right);
-    }
-
-    if (result) {
-      node = splay(value, node);
-    }
-    return result;
-  }
-
-  void deleteNode(int value, Node*& node) {
-    if (!node) {
-      return;
-    }
-
-    if (value < node->value) {
-      deleteNode(value, node->left);
-    } else if (value > node->value) {
-      deleteNode(value, node->right);
-    } else {
-      if (!node->left || !node->right) {
-        Node* temp = node->left ? node->left : node->right;
-        delete node;
-        node = temp;
-      } else {
-        Node*& minNode = findMin(node->right);
-        node->value = minNode->value;
-        deleteNode(minNode->value, node->right);
-      }
-    }
-
-    if (node) {
-      node = splay(value, node);
-    }
-  }
-
-  void deleteTree(Node* node) {
-    if (node) {
-      deleteTree(node->left);
-      deleteTree(node->right);
-      delete node;
-    }
-  }
-
- public:
-  SplayTree()
-      : root(nullptr) {
-  }
-
-  ~SplayTree() {
-    deleteTree(root);
-  }
-
-  void insert(int value) {
-    insert(value, root);
-  }
-
-  bool contains(int value) const {
-    return contains(value, root);
-  }
-
-  Node* find(int value) {
-    return find(value, root);
-  }
-
-  void deleteNode(int value) {
-    deleteNode(value, root);
-  }
-
-  void printTree() {
-    if (!root) {
-      std::cout << "Puste drzewo\n";
-      return;
-    }
-    std::vector<std::vector<std::string>> result = treeToMatrix(root);
-
-    print2DArray(result);
-  }
-};
+#include "SplayTree.h"
 
 int main() {
+  // Every insert splays the new key to the root, so the example trees are shaped by the order
+  // of insertions (and, for the zig-zag cases, by one extra find)
   std::cout << "Zig case (right rotation):\n";
   SplayTree zigTree;
+  zigTree.insert(1);
   zigTree.insert(3);
   zigTree.insert(2);
-  zigTree.insert(1);
   zigTree.printTree();
   zigTree.find(1);
   std::cout << "\nAfter splaying 1:\n";
@@ -222,8 +18,8 @@ int main() {
   std::cout << "\nZag case (left rotation):\n";
   SplayTree zagTree;
   zagTree.insert(1);
-  zagTree.insert(2);
   zagTree.insert(3);
+  zagTree.insert(2);
   zagTree.printTree();
   zagTree.find(3);
   std::cout << "\nAfter splaying 3:\n";
@@ -231,10 +27,10 @@ int main() {
 
   std::cout << "\nZig-zig case:\n";
   SplayTree zigZigTree;
-  zigZigTree.insert(4);
-  zigZigTree.insert(3);
-  zigZigTree.insert(2);
   zigZigTree.insert(1);
+  zigZigTree.insert(2);
+  zigZigTree.insert(3);
+  zigZigTree.insert(4);
   zigZigTree.printTree();
   zigZigTree.find(1);
   std::cout << "\nAfter splaying 1:\n";
@@ -242,10 +38,10 @@ int main() {
 
   std::cout << "\nZag-zag case:\n";
   SplayTree zagZagTree;
-  zagZagTree.insert(1);
-  zagZagTree.insert(2);
-  zagZagTree.insert(3);
   zagZagTree.insert(4);
+  zagZagTree.insert(3);
+  zagZagTree.insert(2);
+  zagZagTree.insert(1);
   zagZagTree.printTree();
   zagZagTree.find(4);
   std::cout << "\nAfter splaying 4:\n";
@@ -253,24 +49,39 @@ int main() {
 
   std::cout << "\nZig-zag case:\n";
   SplayTree zigZagTree;
+  zigZagTree.insert(4);
   zigZagTree.insert(3);
-  zigZagTree.insert(1);
   zigZagTree.insert(2);
+  zigZagTree.insert(1);
+  zigZagTree.find(4);
   zigZagTree.printTree();
-  zigZagTree.find(2);
-  std::cout << "\nAfter splaying 2:\n";
+  zigZagTree.find(3);
+  std::cout << "\nAfter splaying 3:\n";
   zigZagTree.printTree();
 
   std::cout << "\nZag-zig case:\n";
   SplayTree zagZigTree;
   zagZigTree.insert(1);
-  zagZigTree.insert(3);
   zagZigTree.insert(2);
+  zagZigTree.insert(3);
+  zagZigTree.insert(4);
+  zagZigTree.find(1);
   zagZigTree.printTree();
   zagZigTree.find(2);
   std::cout << "\nAfter splaying 2:\n";
   zagZigTree.printTree();
 
+  std::cout << "\nSemi-splaying (zig-zig only lifts the parent):\n";
+  SplayTree semiTree;
+  for (int i = 1; i <= 6; i++) {
+    semiTree.insert(i);
+  }
+  semiTree.setSplayMode(SplayTree::SplayMode::Semi);
+  semiTree.printTree();
+  semiTree.find(1);
+  std::cout << "\nAfter semi-splaying 1:\n";
+  semiTree.printTree();
+
   SplayTree insertTree;
   insertTree.insert(5);
   insertTree.insert(3);
@@ -278,11 +89,14 @@ int main() {
   insertTree.insert(2);
   insertTree.insert(4);
   insertTree.insert(1);
-  std::cout << "Tree after balanced insertions:\n";
+  std::cout << "Tree after insertions (the last key inserted is the root):\n";
   insertTree.printTree();
 
   std::cout << "Contains 4: " << (insertTree.contains(4) ? "true" : "false") << "\n";
   std::cout << "Contains 6: " << (insertTree.contains(6) ? "true" : "false") << "\n";
+  std::cout << "Keys in [2, 5]:";
+  insertTree.forEachInRange(2, 5, [](int value) { std::cout << ' ' << value; });
+  std::cout << "\nFirst key > 5: " << *insertTree.upperBound(5) << "\n";
 
   SplayTree deleteTree;
   deleteTree.insert(5);
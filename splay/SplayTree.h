@@ -0,0 +1,378 @@
+#ifndef SPLAY_TREE_H
+#define SPLAY_TREE_H
+
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "NodePool.h"
+#include "StaticIndex.h"
+#include "TreeIterator.h"
+#include "TreePrinter.h"
+
+struct SplayNode {
+  int value;
+  SplayNode* left;
+  SplayNode* right;
+  SplayNode* parent;  // For iteration and semi-splaying; the root's is nullptr
+
+  SplayNode(int v)
+      : value(v),
+        left(nullptr),
+        right(nullptr),
+        parent(nullptr) {
+  }
+};
+
+// Nodes are allocated from the tree's NodePool and released together with it.
+class SplayTree {
+ public:
+  enum class SplayMode { Full, Semi };
+
+ private:
+  SplayNode* root;
+  NodePool<SplayNode> pool;
+
+  SplayMode mode = SplayMode::Full;
+  unsigned splayPeriod = 1;    // find() restructures on every splayPeriod-th call
+  unsigned depthLimit = 0;     // ... or whenever it went deeper than this (0: no limit)
+  unsigned long long accesses = 0;
+
+  static void setLeft(SplayNode* node, SplayNode* child) {
+    node->left = child;
+    if (child) {
+      child->parent = node;
+    }
+  }
+
+  static void setRight(SplayNode* node, SplayNode* child) {
+    node->right = child;
+    if (child) {
+      child->parent = node;
+    }
+  }
+
+  // The rotations leave the parent of the returned node for the caller to set
+  SplayNode* rotateLeft(SplayNode* node) {
+    if (!node || !node->right) {
+      return node;
+    }
+
+    SplayNode* temp = node->right;
+    setRight(node, temp->left);
+    setLeft(temp, node);
+    return temp;
+  }
+
+  SplayNode* rotateRight(SplayNode* node) {
+    if (!node || !node->left) {
+      return node;
+    }
+
+    SplayNode* temp = node->left;
+    setLeft(node, temp->right);
+    setRight(temp, node);
+    return temp;
+  }
+
+  // Top-down splay (Sleator and Tarjan): walks down from `node` once, hanging the subtrees it
+  // passes on a left tree (keys below `value`) and a right tree (keys above), and finally
+  // reassembles them under the last node on the search path, which is returned with no parent. It
+  // runs in constant extra space, so degenerate trees cannot exhaust the stack.
+  SplayNode* splay(int value, SplayNode* node) {
+    if (!node) {
+      return node;
+    }
+
+    SplayNode header(0);
+    SplayNode* leftMax = &header;   // Largest node of the left tree, which hangs on header.right
+    SplayNode* rightMin = &header;  // Smallest node of the right tree, which hangs on header.left
+
+    while (true) {
+      if (value < node->value) {
+        if (!node->left) {
+          break;
+        }
+        if (value < node->left->value) {
+          // Zig-Zig case
+          node = rotateRight(node);
+          if (!node->left) {
+            break;
+          }
+        }
+        setLeft(rightMin, node);
+        rightMin = node;
+        node = node->left;
+      } else if (value > node->value) {
+        if (!node->right) {
+          break;
+        }
+        if (value > node->right->value) {
+          // Zag-Zag case
+          node = rotateLeft(node);
+          if (!node->right) {
+            break;
+          }
+        }
+        setRight(leftMax, node);
+        leftMax = node;
+        node = node->right;
+      } else {
+        break;
+      }
+    }
+
+    setRight(leftMax, node->left);
+    setLeft(rightMin, node->right);
+    setLeft(node, header.right);
+    setRight(node, header.left);
+    node->parent = nullptr;
+    return node;
+  }
+
+  // Replaces `oldChild` with `newChild` under `parent`, or at the root if there is no parent
+  void relink(SplayNode* parent, SplayNode* oldChild, SplayNode* newChild) {
+    if (!parent) {
+      root = newChild;
+      newChild->parent = nullptr;
+    } else if (parent->left == oldChild) {
+      setLeft(parent, newChild);
+    } else {
+      setRight(parent, newChild);
+    }
+  }
+
+  // Bottom-up semi-splay from `node`. A zig-zig step only rotates the parent over the grandparent
+  // and carries on from the parent, so the accessed node rises about half way and each access
+  // restructures half as much as a full splay.
+  void semiSplay(SplayNode* node) {
+    while (node->parent && node->parent->parent) {
+      SplayNode* parent = node->parent;
+      SplayNode* grandparent = parent->parent;
+      SplayNode* above = grandparent->parent;
+      SplayNode* top;
+      if ((grandparent->left == parent) == (parent->left == node)) {
+        // Zig-Zig / Zag-Zag case: the parent takes the grandparent's place
+        top = grandparent->left == parent ? rotateRight(grandparent) : rotateLeft(grandparent);
+      } else if (grandparent->left == parent) {
+        // Zig-Zag case
+        setLeft(grandparent, rotateLeft(parent));
+        top = rotateRight(grandparent);
+      } else {
+        // Zag-Zig case
+        setRight(grandparent, rotateRight(parent));
+        top = rotateLeft(grandparent);
+      }
+      relink(above, grandparent, top);
+      node = top;
+    }
+    if (node->parent) {
+      // Zig case
+      relink(nullptr, root, root->left == node ? rotateRight(root) : rotateLeft(root));
+    }
+  }
+
+ public:
+  SplayTree()
+      : root(nullptr) {
+  }
+
+  SplayTree(const SplayTree&) = delete;
+  SplayTree& operator=(const SplayTree&) = delete;
+
+  SplayTree(SplayTree&& other) noexcept
+      : root(std::exchange(other.root, nullptr)),
+        pool(std::move(other.pool)),
+        mode(other.mode),
+        splayPeriod(other.splayPeriod),
+        depthLimit(other.depthLimit),
+        accesses(other.accesses) {
+  }
+
+  SplayTree& operator=(SplayTree&& other) noexcept {
+    root = std::exchange(other.root, nullptr);
+    pool = std::move(other.pool);
+    mode = other.mode;
+    splayPeriod = other.splayPeriod;
+    depthLimit = other.depthLimit;
+    accesses = other.accesses;
+    return *this;
+  }
+
+  // How find() restructures the tree. Insertions and deletions always splay fully.
+  void setSplayMode(SplayMode newMode) {
+    mode = newMode;
+  }
+
+  // find() only restructures on every `period`-th call, plus any call whose search went deeper
+  // than `limit` nodes (0 disables the limit). The other calls are plain read-only searches.
+  void setSplayPeriod(unsigned period, unsigned limit = 0) {
+    if (period == 0) {
+      throw std::invalid_argument("Splay period must be positive");
+    }
+    splayPeriod = period;
+    depthLimit = limit;
+  }
+
+  // Splays `value` to the root and hangs the new node above it, splitting the old tree in two
+  void insert(int value) {
+    if (!root) {
+      root = pool.create(value);
+      return;
+    }
+
+    root = splay(value, root);
+    if (root->value == value) {
+      return;
+    }
+
+    SplayNode* node = pool.create(value);
+    if (value < root->value) {
+      setLeft(node, root->left);
+      root->left = nullptr;
+      setRight(node, root);
+    } else {
+      setRight(node, root->right);
+      root->right = nullptr;
+      setLeft(node, root);
+    }
+    root = node;
+  }
+
+  // Plain search that leaves the tree untouched
+  bool contains(int value) const {
+    const SplayNode* node = root;
+    while (node && node->value != value) {
+      node = value < node->value ? node->left : node->right;
+    }
+    return node != nullptr;
+  }
+
+  // Returns the node holding `value`, or nullptr if there is none. By default the last node on
+  // the search path is splayed to the root; setSplayMode() and setSplayPeriod() tone that down.
+  const SplayNode* find(int value) {
+    bool due = ++accesses % splayPeriod == 0;
+    if (mode == SplayMode::Full && due) {
+      root = splay(value, root);
+      return root && root->value == value ? root : nullptr;
+    }
+
+    SplayNode* last = nullptr;
+    size_t depth = 0;
+    for (SplayNode* node = root; node; node = value < node->value ? node->left : node->right) {
+      last = node;
+      depth++;
+      if (node->value == value) {
+        break;
+      }
+    }
+
+    if (last && (due || (depthLimit > 0 && depth > depthLimit))) {
+      if (mode == SplayMode::Semi) {
+        semiSplay(last);
+      } else {
+        root = splay(value, root);
+      }
+    }
+    return last && last->value == value ? last : nullptr;
+  }
+
+  // Splays `value` to the root, then joins its subtrees by splaying the largest key of the left
+  // one, which leaves that key without a right child
+  void deleteNode(int value) {
+    if (!root) {
+      return;
+    }
+
+    root = splay(value, root);
+    if (root->value != value) {
+      return;
+    }
+
+    SplayNode* removed = root;
+    if (!root->left) {
+      root = root->right;
+      if (root) {
+        root->parent = nullptr;
+      }
+    } else {
+      SplayNode* right = root->right;
+      root = splay(value, root->left);
+      setRight(root, right);
+    }
+    pool.destroy(removed);
+  }
+
+  // Iteration and the range queries below only read the tree; nothing is splayed. Iterators stay
+  // valid across insertions and finds, since splaying only relinks nodes.
+  using const_iterator = TreeIterator<SplayNode>;
+
+  const_iterator begin() const {
+    return const_iterator(leftmost(root), &root);
+  }
+
+  const_iterator end() const {
+    return const_iterator(nullptr, &root);
+  }
+
+  // First key not less than `value`
+  const_iterator lowerBound(int value) const {
+    return const_iterator(lowerBoundNode(root, value), &root);
+  }
+
+  // First key greater than `value`
+  const_iterator upperBound(int value) const {
+    return const_iterator(lowerBoundNode(root, value, true), &root);
+  }
+
+  // Calls visit(key) for every key in [low, high] in ascending order. O(depth + k), no allocation.
+  template <typename Visit>
+  void forEachInRange(int low, int high, Visit&& visit) const {
+    forEachNodeInRange(root, low, high, visit);
+  }
+
+  // Drops every node in O(number of slabs)
+  void clear() {
+    root = nullptr;
+    pool.clear();
+  }
+
+  size_t size() const {
+    return pool.size();
+  }
+
+  size_t bytesReserved() const {
+    return pool.bytesReserved();
+  }
+
+  // O(n), without recursion or a stack
+  int height() const {
+    return treeHeight(root);
+  }
+
+  // Keys in ascending order
+  std::vector<int> toSortedVector() const {
+    return collectInorder(root, size());
+  }
+
+  // Read-only snapshot of the current keys in a cache-friendly array layout. Later changes to the
+  // tree do not show up in the snapshot.
+  StaticIndex freeze(StaticIndex::Layout layout = StaticIndex::Layout::Eytzinger) const {
+    return StaticIndex(toSortedVector(), layout);
+  }
+
+  void printTree() {
+    if (!root) {
+      std::cout << "Puste drzewo\n";
+      return;
+    }
+    std::vector<std::vector<std::string>> result = treeToMatrix(root);
+
+    print2DArray(result);
+  }
+};
+
+#endif  // SPLAY_TREE_H
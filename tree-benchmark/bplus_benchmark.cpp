@@ -0,0 +1,165 @@
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "AVLTree.h"
+#include "BPlusTree.h"
+#include "benchmark_utils.h"
+
+// BPlusTree at several node sizes against AVLTree on the same operation streams:
+//
+//   insert       n random keys into an empty tree
+//   point        random lookups, about half of them hits
+//   range_count  number of keys in random ranges about 100 keys wide
+//   range_scan   sum of the keys in the same kind of ranges; AVLTree has no in-order iteration,
+//                so it walks the range with rank + select
+//   mixed        50% lookups, 25% inserts, 25% deletes
+//
+// Each workload yields a checksum that must be the same for every tree.
+//
+//   ./bplus_benchmark [--sizes 1e6,1e7] [--queries 1e6] [--csv data/bplus_benchmark.csv]
+
+struct Workload {
+  std::vector<int> keys;       // Inserted during the insert workload
+  std::vector<int> lookups;    // Also the range starts
+  std::vector<int> mixedKeys;  // Key for each mixed operation
+  std::vector<int> mixedOps;   // 0-1 lookup, 2 insert, 3 delete
+  int rangeWidth;
+};
+
+long long scanRange(const AVLTree& tree, int low, int high) {
+  long long sum = 0;
+  size_t end = tree.rank(high) + (tree.contains(high) ? 1 : 0);
+  for (size_t i = tree.rank(low); i < end; i++) {
+    sum += tree.select(i);
+  }
+  return sum;
+}
+
+template <size_t CacheLines>
+long long scanRange(const BPlusTree<CacheLines>& tree, int low, int high) {
+  long long sum = 0;
+  tree.forEachInRange(low, high, [&](int key) { sum += key; });
+  return sum;
+}
+
+struct Result {
+  std::string workload;
+  double ns;
+  size_t operations;
+  long long checksum;
+};
+
+template <typename Tree>
+std::vector<Result> runWorkloads(const Workload& w) {
+  std::vector<Result> results;
+  Tree tree;
+
+  results.push_back({"insert", timeNs([&] {
+                       for (int key : w.keys) tree.insert(key);
+                     }),
+                     w.keys.size(), static_cast<long long>(tree.size())});
+
+  long long hits = 0;
+  double ns = timeNs([&] {
+    for (int key : w.lookups) hits += tree.contains(key);
+  });
+  results.push_back({"point", ns, w.lookups.size(), hits});
+
+  size_t rangeQueries = w.lookups.size() / 10;
+  long long counted = 0;
+  ns = timeNs([&] {
+    for (size_t i = 0; i < rangeQueries; i++) counted += tree.countInRange(w.lookups[i], w.lookups[i] + w.rangeWidth);
+  });
+  results.push_back({"range_count", ns, rangeQueries, counted});
+
+  long long summed = 0;
+  ns = timeNs([&] {
+    for (size_t i = 0; i < rangeQueries; i++) summed += scanRange(tree, w.lookups[i], w.lookups[i] + w.rangeWidth);
+  });
+  results.push_back({"range_scan", ns, rangeQueries, summed});
+
+  long long mixedHits = 0;
+  ns = timeNs([&] {
+    for (size_t i = 0; i < w.mixedKeys.size(); i++) {
+      int key = w.mixedKeys[i];
+      if (w.mixedOps[i] < 2) {
+        mixedHits += tree.contains(key);
+      } else if (w.mixedOps[i] == 2) {
+        tree.insert(key);
+      } else {
+        tree.deleteNode(key);
+      }
+    }
+  });
+  results.push_back({"mixed", ns, w.mixedKeys.size(), mixedHits * 31 + static_cast<long long>(tree.size())});
+
+  return results;
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<size_t> sizes = {1000000};
+  size_t queryCount = 1000000;
+  std::string csvPath = "data/bplus_benchmark.csv";
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string flag = argv[i];
+    if (flag == "--sizes") {
+      sizes = parseSizes(argv[i + 1]);
+    } else if (flag == "--queries") {
+      queryCount = parseSizes(argv[i + 1]).at(0);
+    } else if (flag == "--csv") {
+      csvPath = argv[i + 1];
+    } else {
+      std::cerr << "Unknown option: " << flag << std::endl;
+      return 1;
+    }
+  }
+
+  ensureParentDirectory(csvPath);
+  std::ofstream csv(csvPath);
+  csv << "tree,workload,size,operations,ns_per_op,checksum,valid\n";
+  bool allValid = true;
+
+  for (size_t size : sizes) {
+    // Keys from [0, 2 * size), so ranges 200 wide hold about 100 keys
+    std::mt19937_64 rng(size);
+    int range = static_cast<int>(2 * size);
+    Workload w;
+    w.rangeWidth = 200;
+    w.keys.resize(size);
+    for (auto& key : w.keys) key = static_cast<int>(rng() % range);
+    w.lookups.resize(queryCount);
+    for (auto& key : w.lookups) key = static_cast<int>(rng() % range);
+    w.mixedKeys.resize(queryCount);
+    w.mixedOps.resize(queryCount);
+    for (size_t i = 0; i < queryCount; i++) {
+      w.mixedKeys[i] = static_cast<int>(rng() % range);
+      w.mixedOps[i] = static_cast<int>(rng() % 4);
+    }
+
+    std::vector<std::pair<std::string, std::vector<Result>>> runs;
+    runs.emplace_back("AVLTree", runWorkloads<AVLTree>(w));
+    runs.emplace_back("BPlusTree<2>", runWorkloads<BPlusTree<2>>(w));
+    runs.emplace_back("BPlusTree<4>", runWorkloads<BPlusTree<4>>(w));
+    runs.emplace_back("BPlusTree<8>", runWorkloads<BPlusTree<8>>(w));
+
+    for (const auto& [tree, results] : runs) {
+      for (size_t r = 0; r < results.size(); r++) {
+        const Result& result = results[r];
+        bool valid = result.checksum == runs[0].second[r].checksum;
+        allValid = allValid && valid;
+        double perOp = result.ns / result.operations;
+        std::cout << result.workload << " / " << size << " / " << tree << ": " << perOp << " ns/op"
+                  << (valid ? "" : " INVALID RESULT") << std::endl;
+        csv << tree << ',' << result.workload << ',' << size << ',' << result.operations << ',' << perOp << ','
+            << result.checksum << ',' << (valid ? "true" : "false") << '\n';
+      }
+    }
+  }
+
+  std::cout << "Results saved to " << csvPath << std::endl;
+  return allValid ? 0 : 1;
+}
@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "AVLTree.h"
+#include "benchmark_utils.h"
+
+// AVLTree bulk operations against the same result built with single-key insert/deleteNode calls:
+// building from sorted keys, and union / intersection / difference of two trees with about half
+// of their keys in common. Every result is checked against std::set_* on the sorted key vectors.
+//
+//   ./bulk_benchmark [--sizes 1e5,1e6,1e7] [--csv data/bulk_benchmark.csv]
+
+struct Contender {
+  std::string operation;
+  std::string method;
+  // Returns the result tree; building the inputs is not timed
+  std::function<AVLTree(const std::vector<int>&, const std::vector<int>&, double&)> run;
+};
+
+std::vector<int> sortedKeys(size_t n, size_t range, std::mt19937_64& rng) {
+  std::vector<int> keys(n);
+  for (auto& key : keys) key = static_cast<int>(rng() % range);
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+  return keys;
+}
+
+AVLTree build(const std::vector<int>& keys) {
+  return AVLTree::fromSorted(keys.begin(), keys.end());
+}
+
+std::vector<Contender> makeContenders() {
+  return {
+      {"build", "insert", [](const std::vector<int>& a, const std::vector<int>&, double& ns) {
+         AVLTree tree;
+         ns = timeNs([&] {
+           for (int key : a) tree.insert(key);
+         });
+         return tree;
+       }},
+      {"build", "fromSorted", [](const std::vector<int>& a, const std::vector<int>&, double& ns) {
+         AVLTree tree;
+         ns = timeNs([&] { tree = AVLTree::fromSorted(a.begin(), a.end()); });
+         return tree;
+       }},
+      {"union", "insert", [](const std::vector<int>& a, const std::vector<int>& b, double& ns) {
+         AVLTree tree = build(a);
+         ns = timeNs([&] {
+           for (int key : b) tree.insert(key);
+         });
+         return tree;
+       }},
+      {"union", "setUnion", [](const std::vector<int>& a, const std::vector<int>& b, double& ns) {
+         AVLTree left = build(a), right = build(b), tree;
+         ns = timeNs([&] { tree = AVLTree::setUnion(std::move(left), std::move(right)); });
+         return tree;
+       }},
+      {"intersection", "insert", [](const std::vector<int>& a, const std::vector<int>& b, double& ns) {
+         AVLTree left = build(a), tree;
+         ns = timeNs([&] {
+           for (int key : b) {
+             if (left.contains(key)) tree.insert(key);
+           }
+         });
+         return tree;
+       }},
+      {"intersection", "setIntersection", [](const std::vector<int>& a, const std::vector<int>& b, double& ns) {
+         AVLTree left = build(a), right = build(b), tree;
+         ns = timeNs([&] { tree = AVLTree::setIntersection(std::move(left), std::move(right)); });
+         return tree;
+       }},
+      {"difference", "deleteNode", [](const std::vector<int>& a, const std::vector<int>& b, double& ns) {
+         AVLTree tree = build(a);
+         ns = timeNs([&] {
+           for (int key : b) tree.deleteNode(key);
+         });
+         return tree;
+       }},
+      {"difference", "setDifference", [](const std::vector<int>& a, const std::vector<int>& b, double& ns) {
+         AVLTree left = build(a), right = build(b), tree;
+         ns = timeNs([&] { tree = AVLTree::setDifference(std::move(left), std::move(right)); });
+         return tree;
+       }},
+  };
+}
+
+bool sameKeys(const AVLTree& tree, const std::vector<int>& expected) {
+  if (tree.size() != expected.size()) {
+    return false;
+  }
+  // Spot-check a thousand positions plus both ends
+  size_t step = std::max<size_t>(1, expected.size() / 1000);
+  for (size_t i = 0; i < expected.size(); i += step) {
+    if (tree.select(i) != expected[i]) return false;
+  }
+  return expected.empty() || tree.select(expected.size() - 1) == expected.back();
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<size_t> sizes = {100000, 1000000};
+  std::string csvPath = "data/bulk_benchmark.csv";
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string flag = argv[i];
+    if (flag == "--sizes") {
+      sizes = parseSizes(argv[i + 1]);
+    } else if (flag == "--csv") {
+      csvPath = argv[i + 1];
+    } else {
+      std::cerr << "Unknown option: " << flag << std::endl;
+      return 1;
+    }
+  }
+
+  ensureParentDirectory(csvPath);
+  std::ofstream csv(csvPath);
+  csv << "operation,method,size,ms,result_size,valid\n";
+  bool allValid = true;
+
+  for (size_t size : sizes) {
+    // Both key sets are drawn from [0, 1.5 * size), so roughly half of each is shared
+    std::mt19937_64 rng(size);
+    std::vector<int> a = sortedKeys(size, size + size / 2, rng);
+    std::vector<int> b = sortedKeys(size, size + size / 2, rng);
+
+    std::vector<int> expectedUnion, expectedIntersection, expectedDifference;
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expectedUnion));
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expectedIntersection));
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expectedDifference));
+
+    for (const auto& contender : makeContenders()) {
+      double ns = 0;
+      AVLTree result = contender.run(a, b, ns);
+
+      const std::vector<int>& expected = contender.operation == "build"          ? a
+                                         : contender.operation == "union"        ? expectedUnion
+                                         : contender.operation == "intersection" ? expectedIntersection
+                                                                                 : expectedDifference;
+      bool valid = sameKeys(result, expected);
+      allValid = allValid && valid;
+
+      std::cout << contender.operation << " / " << size << " / " << contender.method << ": " << ns / 1e6 << " ms"
+                << (valid ? "" : " INVALID RESULT") << std::endl;
+      csv << contender.operation << ',' << contender.method << ',' << size << ',' << ns / 1e6 << ','
+          << result.size() << ',' << (valid ? "true" : "false") << '\n';
+    }
+  }
+
+  std::cout << "Results saved to " << csvPath << std::endl;
+  return allValid ? 0 : 1;
+}
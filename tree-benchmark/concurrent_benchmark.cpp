@@ -0,0 +1,173 @@
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AVLTree.h"
+#include "ConcurrentAVLTree.h"
+#include "benchmark_utils.h"
+
+// Shared ordered set under several threads and update ratios: ConcurrentAVLTree against AVLTree
+// behind a std::shared_mutex (readers share the lock, writers take it exclusively).
+//
+// The set is prefilled with about `size` random keys from [0, 2 * size). Each thread then runs
+// its share of the operations: lookups, and at the given update ratio equally many inserts and
+// deletes of random keys, so the size stays roughly constant. After every run the concurrent
+// tree must be strictly ordered with size() matching its contents, and with one thread both
+// trees must end up with the same size. Lookups count their hits; when the operations run in a
+// fixed order (one thread, or no updates) both trees must report the same hits.
+//
+//   ./concurrent_benchmark [--size 1e6] [--operations 2e6] [--threads 1,2,4,8] [--updates 0,10,50]
+//                          [--csv data/concurrent_benchmark.csv]
+
+class LockedAVLTree {
+  AVLTree tree;
+  mutable std::shared_mutex mutex;
+
+ public:
+  void insert(int value) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    tree.insert(value);
+  }
+
+  bool contains(int value) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return tree.contains(value);
+  }
+
+  void deleteNode(int value) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    tree.deleteNode(value);
+  }
+
+  size_t size() const {
+    return tree.size();
+  }
+};
+
+// Returns the time taken; `hits` gets the number of lookups that found their key
+template <typename Tree>
+double run(Tree& tree, size_t size, size_t operations, size_t threads, int updatePercent, size_t& hits) {
+  int range = static_cast<int>(2 * size);
+  std::mt19937_64 fill(size);
+  for (size_t i = 0; i < size; i++) {
+    tree.insert(static_cast<int>(fill() % range));
+  }
+
+  // Operation streams are generated up front so the timed part only touches the tree
+  std::vector<std::vector<int>> keys(threads);
+  std::vector<std::vector<char>> kinds(threads);  // 'c' contains, 'i' insert, 'd' delete
+  for (size_t t = 0; t < threads; t++) {
+    std::mt19937_64 rng(size * 31 + t);
+    size_t share = operations / threads;
+    keys[t].resize(share);
+    kinds[t].resize(share);
+    for (size_t i = 0; i < share; i++) {
+      keys[t][i] = static_cast<int>(rng() % range);
+      int roll = static_cast<int>(rng() % 200);
+      kinds[t][i] = roll >= 2 * updatePercent ? 'c' : roll % 2 ? 'i' : 'd';
+    }
+  }
+
+  std::vector<size_t> found(threads);
+  double ns = timeNs([&] {
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; t++) {
+      workers.emplace_back([&, t] {
+        // Counted locally: per-operation writes to neighbouring slots of `found` would share a cache line
+        size_t hitCount = 0;
+        for (size_t i = 0; i < keys[t].size(); i++) {
+          int key = keys[t][i];
+          if (kinds[t][i] == 'c') {
+            hitCount += tree.contains(key);
+          } else if (kinds[t][i] == 'i') {
+            tree.insert(key);
+          } else {
+            tree.deleteNode(key);
+          }
+        }
+        found[t] = hitCount;
+      });
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  });
+  hits = 0;
+  for (size_t count : found) hits += count;
+  return ns;
+}
+
+bool consistent(const ConcurrentAVLTree& tree) {
+  std::vector<int> keys = tree.toSortedVector();
+  bool ordered = std::adjacent_find(keys.begin(), keys.end(), std::greater_equal<int>()) == keys.end();
+  return ordered && keys.size() == tree.size();
+}
+
+int main(int argc, char* argv[]) {
+  size_t size = 1000000;
+  size_t operations = 2000000;
+  std::vector<size_t> threadCounts = {1, 2, 4, 8};
+  std::vector<size_t> updatePercents = {0, 10, 50};
+  std::string csvPath = "data/concurrent_benchmark.csv";
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string flag = argv[i];
+    if (flag == "--size") {
+      size = parseSizes(argv[i + 1]).at(0);
+    } else if (flag == "--operations") {
+      operations = parseSizes(argv[i + 1]).at(0);
+    } else if (flag == "--threads") {
+      threadCounts = parseSizes(argv[i + 1]);
+    } else if (flag == "--updates") {
+      updatePercents = parseSizes(argv[i + 1]);
+    } else if (flag == "--csv") {
+      csvPath = argv[i + 1];
+    } else {
+      std::cerr << "Unknown option: " << flag << std::endl;
+      return 1;
+    }
+  }
+
+  ensureParentDirectory(csvPath);
+  std::ofstream csv(csvPath);
+  csv << "tree,threads,update_percent,size,operations,mops_per_s,hits,valid\n";
+  bool allValid = true;
+  std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+
+  for (size_t updates : updatePercents) {
+    for (size_t threads : threadCounts) {
+      size_t concurrentHits = 0;
+      ConcurrentAVLTree concurrent;
+      double concurrentNs = run(concurrent, size, operations, threads, static_cast<int>(updates), concurrentHits);
+      size_t lockedHits = 0;
+      LockedAVLTree locked;
+      double lockedNs = run(locked, size, operations, threads, static_cast<int>(updates), lockedHits);
+
+      bool valid = consistent(concurrent) && (threads > 1 || concurrent.size() == locked.size()) &&
+                   (concurrentHits == lockedHits || (threads > 1 && updates > 0));
+      allValid = allValid && valid;
+
+      size_t done = operations / threads * threads;
+      struct Row {
+        std::string name;
+        double ns;
+        size_t hits;
+      };
+      for (const Row& row : {Row{"ConcurrentAVLTree", concurrentNs, concurrentHits},
+                             Row{"AVLTree+shared_mutex", lockedNs, lockedHits}}) {
+        double mops = done / row.ns * 1e3;
+        std::cout << updates << "% updates / " << threads << " threads / " << row.name << ": " << mops
+                  << " Mops/s, " << row.hits << " hits" << (valid ? "" : " INVALID RESULT") << std::endl;
+        csv << row.name << ',' << threads << ',' << updates << ',' << size << ',' << done << ',' << mops << ','
+            << row.hits << ',' << (valid ? "true" : "false") << '\n';
+      }
+    }
+  }
+
+  std::cout << "Results saved to " << csvPath << std::endl;
+  return allValid ? 0 : 1;
+}
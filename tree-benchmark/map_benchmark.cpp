@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "AVLMap.h"
+#include "benchmark_utils.h"
+
+// AVLMap against std::map with the same key types: int keys, and std::string keys (long enough
+// to live on the heap) looked up through std::string_view with std::less<>. Each run emplaces
+// `size` random keys, looks every key up once in random order, scans the map in order and erases
+// half of the keys. Checksums of what each phase saw must match between the two maps.
+//
+//   ./map_benchmark [--sizes 1e5,1e6] [--csv data/map_benchmark.csv]
+
+struct Phases {
+  double emplaceNs = 0;
+  double findNs = 0;
+  double scanNs = 0;
+  double eraseNs = 0;
+  uint64_t checksum = 0;
+};
+
+// The keys to insert and the same keys as views into separate storage, so the lookups by view
+// never see the map's own strings
+struct StringKeys {
+  std::vector<std::string> owned;
+  std::vector<std::string> lookupStorage;
+  std::vector<std::string_view> lookups;
+};
+
+// std::map only erases by a heterogeneous key from C++23 on
+template <typename K, typename V, typename C, typename Key>
+size_t eraseKey(std::map<K, V, C>& map, const Key& key) {
+  auto it = map.find(key);
+  if (it == map.end()) {
+    return 0;
+  }
+  map.erase(it);
+  return 1;
+}
+
+template <typename K, typename V, typename C, typename Key>
+size_t eraseKey(AVLMap<K, V, C>& map, const Key& key) {
+  return map.erase(key);
+}
+
+template <typename Map, typename Key, typename Lookup>
+Phases runPhases(const std::vector<Key>& keys, const std::vector<Lookup>& lookups) {
+  Phases phases;
+  Map map;
+  uint64_t checksum = 0;
+
+  phases.emplaceNs = timeNs([&] {
+    for (size_t i = 0; i < keys.size(); i++) {
+      checksum += map.emplace(keys[i], i).second;
+    }
+  });
+  phases.findNs = timeNs([&] {
+    for (const Lookup& key : lookups) {
+      auto it = map.find(key);
+      checksum += it == map.end() ? 0 : it->second;
+    }
+  });
+  phases.scanNs = timeNs([&] {
+    uint64_t position = 0;
+    for (const auto& entry : map) {
+      checksum += entry.second * ++position;
+    }
+  });
+  phases.eraseNs = timeNs([&] {
+    for (size_t i = 0; i < lookups.size(); i += 2) {
+      checksum += eraseKey(map, lookups[i]);
+    }
+  });
+  phases.checksum = checksum + map.size();
+  return phases;
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<size_t> sizes = {100000, 1000000};
+  std::string csvPath = "data/map_benchmark.csv";
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string flag = argv[i];
+    if (flag == "--sizes") {
+      sizes = parseSizes(argv[i + 1]);
+    } else if (flag == "--csv") {
+      csvPath = argv[i + 1];
+    } else {
+      std::cerr << "Unknown option: " << flag << std::endl;
+      return 1;
+    }
+  }
+
+  ensureParentDirectory(csvPath);
+  std::ofstream csv(csvPath);
+  csv << "key_type,method,size,emplace_ns,find_ns,scan_ns_per_entry,erase_ns,valid\n";
+  bool allValid = true;
+
+  for (size_t size : sizes) {
+    std::mt19937_64 rng(size);
+
+    std::vector<int> intKeys(size);
+    for (auto& key : intKeys) key = static_cast<int>(rng() % (2 * size));
+    std::vector<int> intLookups = intKeys;
+    std::shuffle(intLookups.begin(), intLookups.end(), rng);
+
+    StringKeys strings;
+    for (int key : intKeys) strings.owned.push_back("customer/" + std::to_string(key) + "/orders");
+    strings.lookupStorage = strings.owned;
+    std::shuffle(strings.lookupStorage.begin(), strings.lookupStorage.end(), rng);
+    for (const auto& key : strings.lookupStorage) strings.lookups.push_back(key);
+
+    struct Run {
+      std::string keyType;
+      std::string method;
+      std::function<Phases()> run;
+    };
+    std::vector<Run> runs = {
+        {"int", "std::map", [&] { return runPhases<std::map<int, uint64_t>>(intKeys, intLookups); }},
+        {"int", "AVLMap", [&] { return runPhases<AVLMap<int, uint64_t>>(intKeys, intLookups); }},
+        {"string", "std::map",
+         [&] { return runPhases<std::map<std::string, uint64_t, std::less<>>>(strings.owned, strings.lookups); }},
+        {"string", "AVLMap",
+         [&] { return runPhases<AVLMap<std::string, uint64_t, std::less<>>>(strings.owned, strings.lookups); }},
+    };
+
+    uint64_t expected[2] = {0, 0};  // std::map's checksum per key type
+    for (const Run& run : runs) {
+      Phases phases = run.run();
+      uint64_t& reference = expected[run.keyType == "string"];
+      if (run.method == "std::map") {
+        reference = phases.checksum;
+      }
+      bool valid = phases.checksum == reference;
+      allValid = allValid && valid;
+
+      double perKey = 1.0 / size;
+      std::cout << size << " / " << run.keyType << " / " << run.method << ": emplace " << phases.emplaceNs * perKey
+                << " ns, find " << phases.findNs * perKey << " ns, scan " << phases.scanNs * perKey
+                << " ns/entry, erase " << phases.eraseNs * 2 * perKey << " ns" << (valid ? "" : " INVALID RESULT")
+                << std::endl;
+      csv << run.keyType << ',' << run.method << ',' << size << ',' << phases.emplaceNs * perKey << ','
+          << phases.findNs * perKey << ',' << phases.scanNs * perKey << ',' << phases.eraseNs * 2 * perKey << ','
+          << (valid ? "true" : "false") << '\n';
+    }
+  }
+
+  std::cout << "Results saved to " << csvPath << std::endl;
+  return allValid ? 0 : 1;
+}
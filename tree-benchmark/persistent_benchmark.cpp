@@ -0,0 +1,134 @@
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "AVLTree.h"
+#include "PersistentAVLTree.h"
+#include "benchmark_utils.h"
+
+// Update throughput and memory per version of PersistentAVLTree. A tree of `size` random keys
+// gets --updates random inserts and deletes (half each); every `interval` updates a snapshot is
+// taken and kept, so all of those versions are alive at the end. Bytes per version are the nodes
+// allocated beyond the current version, divided by the number of snapshots. A full copy of an
+// AVLTree per version is listed for comparison. AVLTree without snapshots is the baseline.
+//
+// The oldest snapshot must still hold the initial keys and the final tree must match std::set.
+//
+//   ./persistent_benchmark [--sizes 1e5,1e6] [--updates 1e5] [--intervals 1,16,256]
+//                          [--csv data/persistent_benchmark.csv]
+
+struct Update {
+  bool insert;
+  int key;
+};
+
+int main(int argc, char* argv[]) {
+  std::vector<size_t> sizes = {100000, 1000000};
+  size_t updateCount = 100000;
+  std::vector<size_t> intervals = {1, 16, 256};
+  std::string csvPath = "data/persistent_benchmark.csv";
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string flag = argv[i];
+    if (flag == "--sizes") {
+      sizes = parseSizes(argv[i + 1]);
+    } else if (flag == "--updates") {
+      updateCount = parseSizes(argv[i + 1]).at(0);
+    } else if (flag == "--intervals") {
+      intervals = parseSizes(argv[i + 1]);
+    } else if (flag == "--csv") {
+      csvPath = argv[i + 1];
+    } else {
+      std::cerr << "Unknown option: " << flag << std::endl;
+      return 1;
+    }
+  }
+
+  ensureParentDirectory(csvPath);
+  std::ofstream csv(csvPath);
+  csv << "method,size,updates,snapshot_interval,versions,build_ns_per_key,ns_per_update,bytes_per_version,"
+         "copy_bytes_per_version,valid\n";
+  bool allValid = true;
+
+  for (size_t size : sizes) {
+    std::mt19937_64 rng(size);
+    int range = static_cast<int>(2 * size);
+    std::vector<int> initialKeys(size);
+    for (auto& key : initialKeys) key = static_cast<int>(rng() % range);
+    std::vector<Update> updates(updateCount);
+    for (auto& update : updates) update = {rng() % 2 == 0, static_cast<int>(rng() % range)};
+
+    std::set<int> reference(initialKeys.begin(), initialKeys.end());
+    std::vector<int> initialSorted(reference.begin(), reference.end());
+    for (const Update& update : updates) {
+      if (update.insert) {
+        reference.insert(update.key);
+      } else {
+        reference.erase(update.key);
+      }
+    }
+    std::vector<int> finalSorted(reference.begin(), reference.end());
+    double copyBytes = static_cast<double>(initialSorted.size()) * sizeof(AVLNode);
+
+    auto report = [&](const std::string& method, size_t interval, size_t versions, double buildNs, double updateNs,
+                      double bytesPerVersion, bool valid) {
+      allValid = allValid && valid;
+      double perKey = buildNs / size;
+      double perUpdate = updateNs / updateCount;
+      std::cout << size << " / " << method << " / interval " << interval << ": build " << perKey << " ns/key, "
+                << perUpdate << " ns/update, " << bytesPerVersion << " B/version (full copy " << copyBytes << ")"
+                << (valid ? "" : " INVALID RESULT") << std::endl;
+      csv << method << ',' << size << ',' << updateCount << ',' << interval << ',' << versions << ',' << perKey << ','
+          << perUpdate << ',' << bytesPerVersion << ',' << copyBytes << ',' << (valid ? "true" : "false") << '\n';
+    };
+
+    {
+      AVLTree tree;
+      double buildNs = timeNs([&] {
+        for (int key : initialKeys) tree.insert(key);
+      });
+      double updateNs = timeNs([&] {
+        for (const Update& update : updates) {
+          if (update.insert) {
+            tree.insert(update.key);
+          } else {
+            tree.deleteNode(update.key);
+          }
+        }
+      });
+      report("AVLTree", 0, 1, buildNs, updateNs, 0, tree.toSortedVector() == finalSorted);
+    }
+
+    for (size_t interval : intervals) {
+      PersistentAVLTree tree;
+      double buildNs = timeNs([&] {
+        for (int key : initialKeys) tree.insert(key);
+      });
+
+      std::vector<PersistentAVLTree::Snapshot> versions;
+      versions.reserve(updateCount / interval + 1);
+      double updateNs = timeNs([&] {
+        for (size_t i = 0; i < updateCount; i++) {
+          if (i % interval == 0) {
+            versions.push_back(tree.snapshot());
+          }
+          if (updates[i].insert) {
+            tree.insert(updates[i].key);
+          } else {
+            tree.deleteNode(updates[i].key);
+          }
+        }
+      });
+
+      size_t extraNodes = tree.nodesAllocated() - tree.size();
+      double bytesPerVersion = static_cast<double>(extraNodes) * sizeof(PersistentAVLNode) / versions.size();
+      bool valid = versions.front().toSortedVector() == initialSorted && tree.toSortedVector() == finalSorted;
+      report("PersistentAVLTree", interval, versions.size(), buildNs, updateNs, bytesPerVersion, valid);
+    }
+  }
+
+  std::cout << "Results saved to " << csvPath << std::endl;
+  return allValid ? 0 : 1;
+}
@@ -0,0 +1,122 @@
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "AVLTree.h"
+#include "BSTTree.h"
+#include "CompactAVLTree.h"
+#include "SplayTree.h"
+#include "benchmark_utils.h"
+
+// Insert / lookup / destroy throughput of the pool-allocated trees. std::set allocates every node
+// separately and frees them one by one on destruction, which is what the trees used to do, so it
+// serves as the baseline. Memory is what each tree's pool has reserved, per key.
+//
+//   ./pool_benchmark [--sizes 1e6,1e7,1e8] [--csv data/pool_benchmark.csv]
+
+struct StdSetTree {
+  std::set<int> keys;
+
+  // libstdc++'s red-black node for an int is 40 bytes, which glibc malloc rounds up to 48
+  size_t bytesReserved() const {
+    return keys.size() * 48;
+  }
+
+  void insert(int value) {
+    keys.insert(value);
+  }
+
+  bool contains(int value) const {
+    return keys.count(value) != 0;
+  }
+};
+
+struct Result {
+  double insertNs;
+  double lookupNs;
+  double destroyNs;
+  size_t hits;
+  double bytesPerKey;
+};
+
+template <typename Tree>
+Result measure(const std::vector<int>& keys, const std::vector<int>& probes) {
+  Result result{};
+  auto tree = std::make_unique<Tree>();
+
+  result.insertNs = timeNs([&] {
+    for (int key : keys) tree->insert(key);
+  });
+  result.bytesPerKey = static_cast<double>(tree->bytesReserved()) / keys.size();
+
+  result.lookupNs = timeNs([&] {
+    for (int probe : probes) result.hits += tree->contains(probe);
+  });
+
+  result.destroyNs = timeNs([&] { tree.reset(); });
+  return result;
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<size_t> sizes = {1000000, 10000000};
+  std::string csvPath = "data/pool_benchmark.csv";
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string flag = argv[i];
+    if (flag == "--sizes") {
+      sizes = parseSizes(argv[i + 1]);
+    } else if (flag == "--csv") {
+      csvPath = argv[i + 1];
+    } else {
+      std::cerr << "Unknown option: " << flag << std::endl;
+      return 1;
+    }
+  }
+
+  std::vector<std::pair<std::string, std::function<Result(const std::vector<int>&, const std::vector<int>&)>>> trees = {
+      {"AVLTree", measure<AVLTree>},
+      {"CompactAVLTree", measure<CompactAVLTree>},
+      {"BSTTree", measure<BSTTree>},
+      {"SplayTree", measure<SplayTree>},
+      {"std::set", measure<StdSetTree>},
+  };
+
+  ensureParentDirectory(csvPath);
+  std::ofstream csv(csvPath);
+  csv << "tree,size,insert_mops,lookup_mops,destroy_ms,bytes_per_key\n";
+
+  for (size_t size : sizes) {
+    // Uniform random keys; half of the probes hit, half are fresh random values
+    std::mt19937_64 rng(size);
+    std::vector<int> keys(size);
+    for (auto& key : keys) key = static_cast<int>(rng());
+    std::vector<int> probes(size);
+    for (size_t i = 0; i < size; i++) probes[i] = i % 2 ? keys[rng() % size] : static_cast<int>(rng());
+
+    size_t expectedHits = 0;
+    for (const auto& [name, run] : trees) {
+      Result r = run(keys, probes);
+      if (name == trees.front().first) {
+        expectedHits = r.hits;
+      } else if (r.hits != expectedHits) {
+        std::cerr << name << ": " << r.hits << " hits, expected " << expectedHits << std::endl;
+        return 1;
+      }
+
+      double insertMops = size / r.insertNs * 1e3;
+      double lookupMops = size / r.lookupNs * 1e3;
+      std::cout << name << " / " << size << ": insert " << insertMops << " Mops/s, lookup " << lookupMops
+                << " Mops/s, destroy " << r.destroyNs / 1e6 << " ms, " << r.bytesPerKey << " B/key" << std::endl;
+      csv << name << ',' << size << ',' << insertMops << ',' << lookupMops << ',' << r.destroyNs / 1e6 << ','
+          << r.bytesPerKey << '\n';
+    }
+  }
+
+  std::cout << "Results saved to " << csvPath << std::endl;
+  return 0;
+}
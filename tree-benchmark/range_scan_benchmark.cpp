@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <climits>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "AVLTree.h"
+#include "BPlusTree.h"
+#include "BSTTree.h"
+#include "SplayTree.h"
+#include "benchmark_utils.h"
+
+// Scan throughput: a full in-order pass with iterators, then forEachInRange over windows that
+// hold about `width` keys each, for the pointer trees, the B+tree, std::set and a sorted vector.
+// Keys are random from [0, 2 * size); every contender must visit the same keys, which is checked
+// with the sum of everything visited.
+//
+//   ./range_scan_benchmark [--sizes 1e6,1e7] [--widths 16,1024,65536] [--keys 1e7]
+//                          [--csv data/range_scan_benchmark.csv]
+//
+// --keys is the number of keys each range workload visits in total, so every width does a
+// comparable amount of scanning.
+
+struct Contender {
+  std::string method;
+  std::function<long long()> fullScan;
+  std::function<long long(const std::vector<int>&, int)> rangeScan;  // Window starts, key width
+};
+
+template <typename Tree>
+Contender treeContender(const std::string& method, const Tree& tree) {
+  return {method,
+          [&tree] {
+            long long sum = 0;
+            for (int key : tree) sum += key;
+            return sum;
+          },
+          [&tree](const std::vector<int>& starts, int span) {
+            long long sum = 0;
+            for (int start : starts) tree.forEachInRange(start, start + span - 1, [&](int key) { sum += key; });
+            return sum;
+          }};
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<size_t> sizes = {1000000};
+  std::vector<size_t> widths = {16, 1024, 65536};
+  size_t keysPerWorkload = 10000000;
+  std::string csvPath = "data/range_scan_benchmark.csv";
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string flag = argv[i];
+    if (flag == "--sizes") {
+      sizes = parseSizes(argv[i + 1]);
+    } else if (flag == "--widths") {
+      widths = parseSizes(argv[i + 1]);
+    } else if (flag == "--keys") {
+      keysPerWorkload = parseSizes(argv[i + 1]).at(0);
+    } else if (flag == "--csv") {
+      csvPath = argv[i + 1];
+    } else {
+      std::cerr << "Unknown option: " << flag << std::endl;
+      return 1;
+    }
+  }
+
+  ensureParentDirectory(csvPath);
+  std::ofstream csv(csvPath);
+  csv << "method,size,workload,width,keys_visited,ns_per_key,valid\n";
+  bool allValid = true;
+
+  for (size_t size : sizes) {
+    std::mt19937_64 rng(size);
+    int range = static_cast<int>(2 * size);
+    std::vector<int> insertionOrder(size);
+    for (auto& key : insertionOrder) key = static_cast<int>(rng() % range);
+
+    AVLTree avl;
+    BSTTree bst;
+    SplayTree splay;
+    BPlusTree<4> bplus;
+    std::set<int> stdSet;
+    for (int key : insertionOrder) {
+      avl.insert(key);
+      bst.insert(key);
+      splay.insert(key);
+      bplus.insert(key);
+      stdSet.insert(key);
+    }
+    std::vector<int> sorted = avl.toSortedVector();
+    // Same keys, but the pool hands out nodes in key order, so a scan walks memory sequentially
+    AVLTree packedAvl = AVLTree::fromSorted(sorted.begin(), sorted.end());
+
+    std::vector<Contender> contenders = {
+        treeContender("AVLTree", avl),
+        treeContender("AVLTree fromSorted", packedAvl),
+        treeContender("BSTTree", bst),
+        treeContender("SplayTree", splay),
+        {"BPlusTree<4>",
+         [&] {
+           long long sum = 0;
+           bplus.forEachInRange(INT_MIN, INT_MAX, [&](int key) { sum += key; });
+           return sum;
+         },
+         [&](const std::vector<int>& starts, int span) {
+           long long sum = 0;
+           for (int start : starts) bplus.forEachInRange(start, start + span - 1, [&](int key) { sum += key; });
+           return sum;
+         }},
+        {"std::set",
+         [&] {
+           long long sum = 0;
+           for (int key : stdSet) sum += key;
+           return sum;
+         },
+         [&](const std::vector<int>& starts, int span) {
+           long long sum = 0;
+           for (int start : starts) {
+             for (auto it = stdSet.lower_bound(start); it != stdSet.end() && *it < start + span; ++it) sum += *it;
+           }
+           return sum;
+         }},
+        {"sorted vector",
+         [&] {
+           long long sum = 0;
+           for (int key : sorted) sum += key;
+           return sum;
+         },
+         [&](const std::vector<int>& starts, int span) {
+           long long sum = 0;
+           for (int start : starts) {
+             for (auto it = std::lower_bound(sorted.begin(), sorted.end(), start);
+                  it != sorted.end() && *it < start + span; ++it) {
+               sum += *it;
+             }
+           }
+           return sum;
+         }},
+    };
+
+    // Expected sums straight from the sorted keys
+    std::vector<long long> prefix(sorted.size() + 1, 0);
+    for (size_t i = 0; i < sorted.size(); i++) prefix[i + 1] = prefix[i] + sorted[i];
+    auto sumBelow = [&](long long bound) {
+      return prefix[std::lower_bound(sorted.begin(), sorted.end(), bound) - sorted.begin()];
+    };
+
+    struct Workload {
+      std::string name;
+      size_t width;
+      std::vector<int> starts;
+      int span;
+      long long expectedSum;
+      size_t keysVisited;
+    };
+    std::vector<Workload> workloads;
+    workloads.push_back({"full_scan", sorted.size(), {}, 0, prefix.back(), sorted.size()});
+    for (size_t width : widths) {
+      // Keys are about half as dense as the key range, so a window of 2 * width values holds
+      // about `width` keys
+      int span = static_cast<int>(std::min<size_t>(2 * width, range));
+      size_t windows = std::max<size_t>(1, keysPerWorkload / width);
+      Workload workload{"range", width, std::vector<int>(windows), span, 0, 0};
+      for (auto& start : workload.starts) {
+        start = static_cast<int>(rng() % (range - span + 1));
+        workload.expectedSum += sumBelow(static_cast<long long>(start) + span) - sumBelow(start);
+        workload.keysVisited += std::lower_bound(sorted.begin(), sorted.end(), start + span) -
+                                std::lower_bound(sorted.begin(), sorted.end(), start);
+      }
+      workloads.push_back(std::move(workload));
+    }
+
+    for (const Workload& workload : workloads) {
+      for (const Contender& contender : contenders) {
+        long long sum = 0;
+        double ns = timeNs([&] {
+          sum = workload.starts.empty() ? contender.fullScan() : contender.rangeScan(workload.starts, workload.span);
+        });
+        bool valid = sum == workload.expectedSum;
+        allValid = allValid && valid;
+
+        double perKey = workload.keysVisited ? ns / workload.keysVisited : 0;
+        std::cout << size << " / " << workload.name << " " << workload.width << " / " << contender.method << ": "
+                  << perKey << " ns/key" << (valid ? "" : " INVALID RESULT") << std::endl;
+        csv << contender.method << ',' << size << ',' << workload.name << ',' << workload.width << ','
+            << workload.keysVisited << ',' << perKey << ',' << (valid ? "true" : "false") << '\n';
+      }
+    }
+  }
+
+  std::cout << "Results saved to " << csvPath << std::endl;
+  return allValid ? 0 : 1;
+}
@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "AVLTree.h"
+#include "SplayTree.h"
+#include "benchmark_utils.h"
+
+// Lookups under skewed and sequential access: the splay tree's find() in each restructuring mode
+// against AVLTree::contains. Every query hits, so each contender must return the queried key every
+// time; the sum of the keys found is checked against the sum of the queries.
+//
+//   zipf        keys inserted in random order, queries Zipf-distributed (s = --skew) over a random
+//               ranking of the keys, so the hot keys are scattered over the key range
+//   sequential  keys inserted in ascending order (a degenerate path for the splay tree), then
+//               queried in ascending order, repeated until --queries lookups have been made
+//   uniform     keys inserted in random order, uniformly random queries, as a baseline
+//
+//   ./splay_benchmark [--sizes 1e5,1e6] [--queries 1e6] [--skew 0.99] [--csv data/splay_benchmark.csv]
+
+struct Contender {
+  std::string method;
+  SplayTree::SplayMode mode;
+  unsigned period;
+  unsigned depthLimit;
+};
+
+int main(int argc, char* argv[]) {
+  std::vector<size_t> sizes = {100000, 1000000};
+  size_t queryCount = 1000000;
+  double skew = 0.99;
+  std::string csvPath = "data/splay_benchmark.csv";
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string flag = argv[i];
+    if (flag == "--sizes") {
+      sizes = parseSizes(argv[i + 1]);
+    } else if (flag == "--queries") {
+      queryCount = parseSizes(argv[i + 1]).at(0);
+    } else if (flag == "--skew") {
+      skew = std::stod(argv[i + 1]);
+    } else if (flag == "--csv") {
+      csvPath = argv[i + 1];
+    } else {
+      std::cerr << "Unknown option: " << flag << std::endl;
+      return 1;
+    }
+  }
+
+  ensureParentDirectory(csvPath);
+  std::ofstream csv(csvPath);
+  csv << "pattern,method,size,queries,build_ns_per_key,ns_per_query,valid\n";
+  bool allValid = true;
+
+  for (size_t size : sizes) {
+    std::mt19937_64 rng(size);
+    std::vector<int> sorted(size);
+    std::iota(sorted.begin(), sorted.end(), 0);
+    std::vector<int> shuffled = sorted;
+    std::shuffle(shuffled.begin(), shuffled.end(), rng);
+
+    std::vector<int> uniformQueries(queryCount);
+    for (auto& query : uniformQueries) query = static_cast<int>(rng() % size);
+    std::vector<int> sequentialQueries(queryCount);
+    for (size_t i = 0; i < queryCount; i++) sequentialQueries[i] = static_cast<int>(i % size);
+
+    struct Pattern {
+      std::string name;
+      const std::vector<int>* insertionOrder;
+      std::vector<int> queries;
+    };
+    std::vector<Pattern> patterns = {
+        {"zipf", &shuffled, zipfQueries(sorted, queryCount, skew, rng)},
+        {"sequential", &sorted, sequentialQueries},
+        {"uniform", &shuffled, uniformQueries},
+    };
+
+    // Splaying every 16th access, or any access deeper than about twice the balanced height
+    unsigned deepAccess = 2 * static_cast<unsigned>(std::log2(static_cast<double>(size)) + 1);
+    std::vector<Contender> contenders = {
+        {"SplayTree full", SplayTree::SplayMode::Full, 1, 0},
+        {"SplayTree semi", SplayTree::SplayMode::Semi, 1, 0},
+        {"SplayTree full every 4th", SplayTree::SplayMode::Full, 4, 0},
+        {"SplayTree semi every 4th", SplayTree::SplayMode::Semi, 4, 0},
+        {"SplayTree full every 16th or deep", SplayTree::SplayMode::Full, 16, deepAccess},
+    };
+
+    for (const Pattern& pattern : patterns) {
+      long long expectedSum = std::accumulate(pattern.queries.begin(), pattern.queries.end(), 0LL);
+
+      auto report = [&](const std::string& method, double buildNs, double queryNs, long long sum) {
+        bool valid = sum == expectedSum;
+        allValid = allValid && valid;
+        double perKey = buildNs / size;
+        double perQuery = queryNs / queryCount;
+        std::cout << size << " / " << pattern.name << " / " << method << ": build " << perKey << " ns/key, "
+                  << perQuery << " ns/query" << (valid ? "" : " INVALID RESULT") << std::endl;
+        csv << pattern.name << ',' << method << ',' << size << ',' << queryCount << ',' << perKey << ','
+            << perQuery << ',' << (valid ? "true" : "false") << '\n';
+      };
+
+      {
+        AVLTree avl;
+        double buildNs = timeNs([&] {
+          for (int key : *pattern.insertionOrder) avl.insert(key);
+        });
+        long long sum = 0;
+        double queryNs = timeNs([&] {
+          for (int query : pattern.queries) sum += avl.contains(query) ? query : -1;
+        });
+        report("AVLTree::contains", buildNs, queryNs, sum);
+      }
+
+      for (const Contender& contender : contenders) {
+        SplayTree splay;
+        splay.setSplayMode(contender.mode);
+        splay.setSplayPeriod(contender.period, contender.depthLimit);
+        double buildNs = timeNs([&] {
+          for (int key : *pattern.insertionOrder) splay.insert(key);
+        });
+        long long sum = 0;
+        double queryNs = timeNs([&] {
+          for (int query : pattern.queries) {
+            const SplayNode* node = splay.find(query);
+            sum += node ? node->value : -1;
+          }
+        });
+        report(contender.method, buildNs, queryNs, sum);
+      }
+    }
+  }
+
+  std::cout << "Results saved to " << csvPath << std::endl;
+  return allValid ? 0 : 1;
+}
@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "AVLTree.h"
+#include "BSTTree.h"
+#include "SplayTree.h"
+#include "StaticIndex.h"
+#include "benchmark_utils.h"
+
+// Read-only lookups on a frozen key set: the live pointer trees against std::lower_bound on the
+// sorted vector and the StaticIndex layouts (single and batched lowerBound). The keys are random,
+// the queries are random too and about half of them hit. Every contender must agree with
+// std::lower_bound on every query.
+//
+//   ./static_index_benchmark [--sizes 1e4,1e6,1e7] [--queries 1e6] [--csv data/static_index_benchmark.csv]
+
+struct Contender {
+  std::string method;
+  // Answers every query; the result for a query with no lowerBound is INT_MIN
+  std::function<void(const std::vector<int>&, std::vector<int>&)> run;
+};
+
+constexpr int NOT_FOUND = std::numeric_limits<int>::min();
+
+int orNotFound(std::optional<int> found) {
+  return found ? *found : NOT_FOUND;
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<size_t> sizes = {10000, 1000000};
+  size_t queryCount = 1000000;
+  std::string csvPath = "data/static_index_benchmark.csv";
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string flag = argv[i];
+    if (flag == "--sizes") {
+      sizes = parseSizes(argv[i + 1]);
+    } else if (flag == "--queries") {
+      queryCount = parseSizes(argv[i + 1]).at(0);
+    } else if (flag == "--csv") {
+      csvPath = argv[i + 1];
+    } else {
+      std::cerr << "Unknown option: " << flag << std::endl;
+      return 1;
+    }
+  }
+
+  ensureParentDirectory(csvPath);
+  std::ofstream csv(csvPath);
+  csv << "method,size,queries,ns_per_query,bytes_per_key,valid\n";
+  bool allValid = true;
+
+  for (size_t size : sizes) {
+    // Keys from [0, 2 * size), so a uniform query in the same range hits about half of the time
+    std::mt19937_64 rng(size);
+    int range = static_cast<int>(2 * size);
+    std::vector<int> insertionOrder(size);
+    for (auto& key : insertionOrder) key = static_cast<int>(rng() % range);
+    std::vector<int> queries(queryCount);
+    for (auto& query : queries) query = static_cast<int>(rng() % (range + 1));
+
+    AVLTree avl;
+    BSTTree bst;
+    SplayTree splay;
+    for (int key : insertionOrder) {
+      avl.insert(key);
+      bst.insert(key);
+      splay.insert(key);
+    }
+    std::vector<int> sorted = avl.toSortedVector();
+    StaticIndex eytzinger = avl.freeze(StaticIndex::Layout::Eytzinger);
+    StaticIndex vanEmdeBoas = avl.freeze(StaticIndex::Layout::VanEmdeBoas);
+
+    std::vector<int> expected(queryCount);
+    for (size_t i = 0; i < queryCount; i++) {
+      auto it = std::lower_bound(sorted.begin(), sorted.end(), queries[i]);
+      expected[i] = it == sorted.end() ? NOT_FOUND : *it;
+    }
+
+    // The pointer trees only answer membership, so their results are checked against that instead
+    auto membership = [&](auto& tree) {
+      return [&tree](const std::vector<int>& q, std::vector<int>& out) {
+        for (size_t i = 0; i < q.size(); i++) out[i] = tree.contains(q[i]) ? q[i] : NOT_FOUND;
+      };
+    };
+
+    std::vector<std::pair<Contender, size_t>> contenders = {
+        {{"AVLTree::contains", membership(avl)}, avl.bytesReserved()},
+        {{"BSTTree::contains", membership(bst)}, bst.bytesReserved()},
+        {{"SplayTree::contains", membership(splay)}, splay.bytesReserved()},
+        {{"std::lower_bound",
+          [&](const std::vector<int>& q, std::vector<int>& out) {
+            for (size_t i = 0; i < q.size(); i++) {
+              auto it = std::lower_bound(sorted.begin(), sorted.end(), q[i]);
+              out[i] = it == sorted.end() ? NOT_FOUND : *it;
+            }
+          }},
+         sorted.size() * sizeof(int)},
+        {{"Eytzinger",
+          [&](const std::vector<int>& q, std::vector<int>& out) {
+            for (size_t i = 0; i < q.size(); i++) out[i] = orNotFound(eytzinger.lowerBound(q[i]));
+          }},
+         eytzinger.bytes()},
+        {{"Eytzinger batch",
+          [&](const std::vector<int>& q, std::vector<int>& out) {
+            std::vector<std::optional<int>> found(q.size());
+            eytzinger.lowerBound(q.data(), q.size(), found.data());
+            for (size_t i = 0; i < q.size(); i++) out[i] = orNotFound(found[i]);
+          }},
+         eytzinger.bytes()},
+        {{"VanEmdeBoas",
+          [&](const std::vector<int>& q, std::vector<int>& out) {
+            for (size_t i = 0; i < q.size(); i++) out[i] = orNotFound(vanEmdeBoas.lowerBound(q[i]));
+          }},
+         vanEmdeBoas.bytes()},
+    };
+
+    for (const auto& [contender, bytes] : contenders) {
+      std::vector<int> results(queryCount);
+      double ns = timeNs([&] { contender.run(queries, results); });
+
+      bool membershipOnly = contender.method.find("::contains") != std::string::npos;
+      bool valid = true;
+      for (size_t i = 0; i < queryCount && valid; i++) {
+        int want = membershipOnly ? (expected[i] == queries[i] ? queries[i] : NOT_FOUND) : expected[i];
+        valid = results[i] == want;
+      }
+      allValid = allValid && valid;
+
+      double perQuery = ns / queryCount;
+      double bytesPerKey = sorted.empty() ? 0 : static_cast<double>(bytes) / sorted.size();
+      std::cout << size << " / " << contender.method << ": " << perQuery << " ns/query, " << bytesPerKey
+                << " B/key" << (valid ? "" : " INVALID RESULT") << std::endl;
+      csv << contender.method << ',' << size << ',' << queryCount << ',' << perQuery << ',' << bytesPerKey << ','
+          << (valid ? "true" : "false") << '\n';
+    }
+  }
+
+  std::cout << "Results saved to " << csvPath << std::endl;
+  return allValid ? 0 : 1;
+}
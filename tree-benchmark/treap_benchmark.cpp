@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "AVLTree.h"
+#include "BSTTree.h"
+#include "Treap.h"
+#include "benchmark_utils.h"
+
+// Treap against the unbalanced BSTTree and AVLTree for keys arriving sorted, in random order and
+// reversed. Each run inserts `size` distinct keys in that order, looks every key up once in random
+// order and deletes them all in random order. Sorted and reversed input degrade BSTTree to a list
+// with O(n^2) total work, so it only runs them up to --bst-limit keys and is listed as skipped
+// above that. The keys found and the sorted contents after the inserts must match for every tree.
+//
+//   ./treap_benchmark [--sizes 1e4,1e6] [--bst-limit 3e4] [--csv data/treap_benchmark.csv]
+
+struct Phases {
+  double insertNs = 0;
+  double findNs = 0;
+  double eraseNs = 0;
+  bool valid = false;
+};
+
+template <typename Tree>
+Phases runPhases(const std::vector<int>& order, const std::vector<int>& lookups) {
+  Phases phases;
+  Tree tree;
+  phases.insertNs = timeNs([&] {
+    for (int key : order) tree.insert(key);
+  });
+  bool sorted = tree.toSortedVector() == [&] {
+    std::vector<int> keys = order;
+    std::sort(keys.begin(), keys.end());
+    return keys;
+  }();
+
+  size_t found = 0;
+  phases.findNs = timeNs([&] {
+    for (int key : lookups) found += tree.contains(key);
+  });
+  phases.eraseNs = timeNs([&] {
+    for (int key : lookups) tree.deleteNode(key);
+  });
+  phases.valid = sorted && found == order.size() && tree.size() == 0;
+  return phases;
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<size_t> sizes = {10000, 1000000};
+  size_t bstLimit = 30000;
+  std::string csvPath = "data/treap_benchmark.csv";
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string flag = argv[i];
+    if (flag == "--sizes") {
+      sizes = parseSizes(argv[i + 1]);
+    } else if (flag == "--bst-limit") {
+      bstLimit = parseSizes(argv[i + 1]).at(0);
+    } else if (flag == "--csv") {
+      csvPath = argv[i + 1];
+    } else {
+      std::cerr << "Unknown option: " << flag << std::endl;
+      return 1;
+    }
+  }
+
+  ensureParentDirectory(csvPath);
+  std::ofstream csv(csvPath);
+  csv << "order,method,size,insert_ns,find_ns,erase_ns,valid\n";
+  bool allValid = true;
+
+  for (size_t size : sizes) {
+    std::mt19937_64 rng(size);
+    std::vector<int> sorted(size);
+    std::iota(sorted.begin(), sorted.end(), 0);
+    std::vector<int> shuffled = sorted;
+    std::shuffle(shuffled.begin(), shuffled.end(), rng);
+    std::vector<int> reversed(sorted.rbegin(), sorted.rend());
+    std::vector<int> lookups = sorted;
+    std::shuffle(lookups.begin(), lookups.end(), rng);
+
+    struct Order {
+      std::string name;
+      const std::vector<int>& keys;
+      bool degenerate;
+    };
+    std::vector<Order> orders = {{"sorted", sorted, true}, {"random", shuffled, false}, {"reversed", reversed, true}};
+
+    for (const Order& order : orders) {
+      for (const std::string method : {"BSTTree", "AVLTree", "Treap"}) {
+        if (method == "BSTTree" && order.degenerate && size > bstLimit) {
+          std::cout << size << " / " << order.name << " / " << method << ": skipped (above --bst-limit)"
+                    << std::endl;
+          continue;
+        }
+        Phases phases = method == "BSTTree"   ? runPhases<BSTTree>(order.keys, lookups)
+                        : method == "AVLTree" ? runPhases<AVLTree>(order.keys, lookups)
+                                              : runPhases<Treap>(order.keys, lookups);
+        allValid = allValid && phases.valid;
+
+        double perKey = 1.0 / size;
+        std::cout << size << " / " << order.name << " / " << method << ": insert " << phases.insertNs * perKey
+                  << " ns, find " << phases.findNs * perKey << " ns, erase " << phases.eraseNs * perKey << " ns"
+                  << (phases.valid ? "" : " INVALID RESULT") << std::endl;
+        csv << order.name << ',' << method << ',' << size << ',' << phases.insertNs * perKey << ','
+            << phases.findNs * perKey << ',' << phases.eraseNs * perKey << ',' << (phases.valid ? "true" : "false")
+            << '\n';
+      }
+    }
+  }
+
+  std::cout << "Results saved to " << csvPath << std::endl;
+  return allValid ? 0 : 1;
+}
@@ -0,0 +1,220 @@
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "AVLTree.h"
+#include "BSTTree.h"
+#include "SplayTree.h"
+#include "Treap.h"
+#include "benchmark_utils.h"
+
+// One workload matrix for every ordered int set in avl/, bst/ and splay/. Each tree starts from
+// `size` keys drawn from the universe [0, 2 * size) and inserted in random order, then runs --ops
+// operations for every access pattern and operation mix in turn, on the same tree:
+//
+//   uniform      keys uniformly random over the universe
+//   zipf         Zipf-distributed (s = --skew) over a random ranking of the universe
+//   sequential   ascending sweep over the universe, wrapping around
+//   working-set  uniform over --working-set keys at a time; the set moves to other random keys 16
+//                times per run
+//
+//   mixes        lookup/insert/delete percentages 90/5/5, 50/25/25 and 10/45/45
+//
+// Lookups go through SplayTree::find(), so they splay; the other trees use contains(). Reported per
+// run: ns per operation, the tree's height afterwards, sizeof(node) and pool bytes reserved per key.
+// Every tree must see the same lookup hits and sizes as AVLTree, which runs first, and end up with
+// the same keys.
+//
+//   ./tree_benchmark [--sizes 1e3,1e5,1e6] [--ops 1e6] [--skew 0.99] [--working-set 4096]
+//                    [--csv data/tree_benchmark.csv]
+
+struct Workload {
+  std::string pattern;
+  std::string mix;
+  std::vector<int> keys;
+  std::vector<uint8_t> kinds;  // 0 lookup, 1 insert, 2 delete
+};
+
+struct Result {
+  double nsPerOp = 0;
+  int height = 0;
+  double reservedPerKey = 0;
+  uint64_t checksum = 0;
+};
+
+template <typename Tree>
+bool lookup(Tree& tree, int key) {
+  return tree.contains(key);
+}
+
+bool lookup(SplayTree& tree, int key) {
+  return tree.find(key) != nullptr;
+}
+
+// Build time per key, one result per workload, and a checksum of the final keys
+template <typename Tree>
+std::vector<Result> runTree(const std::vector<int>& initialKeys, const std::vector<Workload>& workloads,
+                            double& buildNs, uint64_t& finalChecksum) {
+  Tree tree;
+  buildNs = timeNs([&] {
+               for (int key : initialKeys) tree.insert(key);
+             }) /
+            initialKeys.size();
+
+  std::vector<Result> results;
+  for (const Workload& workload : workloads) {
+    Result result;
+    uint64_t hits = 0;
+    double ns = timeNs([&] {
+      for (size_t i = 0; i < workload.keys.size(); i++) {
+        int key = workload.keys[i];
+        switch (workload.kinds[i]) {
+          case 0:
+            hits += lookup(tree, key);
+            break;
+          case 1:
+            tree.insert(key);
+            break;
+          default:
+            tree.deleteNode(key);
+        }
+      }
+    });
+    result.nsPerOp = ns / workload.keys.size();
+    result.height = tree.height();
+    result.reservedPerKey = tree.size() ? static_cast<double>(tree.bytesReserved()) / tree.size() : 0;
+    result.checksum = hits * 1000003 + tree.size();
+    results.push_back(result);
+  }
+
+  finalChecksum = 0;
+  for (int key : tree) finalChecksum = finalChecksum * 31 + key;
+  return results;
+}
+
+std::vector<int> patternKeys(const std::string& pattern, const std::vector<int>& universe, size_t count,
+                             double skew, size_t workingSet, std::mt19937_64& rng) {
+  std::vector<int> keys(count);
+  if (pattern == "uniform") {
+    for (auto& key : keys) key = universe[rng() % universe.size()];
+  } else if (pattern == "zipf") {
+    keys = zipfQueries(universe, count, skew, rng);
+  } else if (pattern == "sequential") {
+    size_t start = rng() % universe.size();
+    for (size_t i = 0; i < count; i++) keys[i] = universe[(start + i) % universe.size()];
+  } else {
+    std::vector<int> shuffled = universe;
+    std::shuffle(shuffled.begin(), shuffled.end(), rng);
+    size_t setSize = std::min(workingSet, shuffled.size());
+    size_t phaseLength = std::max<size_t>(count / 16, 1);
+    for (size_t i = 0; i < count; i++) {
+      size_t base = (i / phaseLength * setSize) % (shuffled.size() - setSize + 1);
+      keys[i] = shuffled[base + rng() % setSize];
+    }
+  }
+  return keys;
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<size_t> sizes = {1000, 100000, 1000000};
+  size_t opCount = 1000000;
+  double skew = 0.99;
+  size_t workingSet = 4096;
+  std::string csvPath = "data/tree_benchmark.csv";
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string flag = argv[i];
+    if (flag == "--sizes") {
+      sizes = parseSizes(argv[i + 1]);
+    } else if (flag == "--ops") {
+      opCount = parseSizes(argv[i + 1]).at(0);
+    } else if (flag == "--skew") {
+      skew = std::stod(argv[i + 1]);
+    } else if (flag == "--working-set") {
+      workingSet = parseSizes(argv[i + 1]).at(0);
+    } else if (flag == "--csv") {
+      csvPath = argv[i + 1];
+    } else {
+      std::cerr << "Unknown option: " << flag << std::endl;
+      return 1;
+    }
+  }
+
+  ensureParentDirectory(csvPath);
+  std::ofstream csv(csvPath);
+  csv << "method,size,pattern,mix,ops,build_ns_per_key,ns_per_op,height,node_bytes,reserved_bytes_per_key,valid\n";
+  bool allValid = true;
+
+  const std::vector<std::string> patterns = {"uniform", "zipf", "sequential", "working-set"};
+  struct Mix {
+    std::string name;
+    unsigned lookups;
+    unsigned inserts;
+  };
+  const std::vector<Mix> mixes = {{"90/5/5", 90, 5}, {"50/25/25", 50, 25}, {"10/45/45", 10, 45}};
+
+  for (size_t size : sizes) {
+    std::mt19937_64 rng(size);
+    std::vector<int> universe(2 * size);
+    std::iota(universe.begin(), universe.end(), 0);
+    std::vector<int> initialKeys = universe;
+    std::shuffle(initialKeys.begin(), initialKeys.end(), rng);
+    initialKeys.resize(size);
+
+    std::vector<Workload> workloads;
+    for (const std::string& pattern : patterns) {
+      std::vector<int> keys = patternKeys(pattern, universe, opCount, skew, workingSet, rng);
+      for (const Mix& mix : mixes) {
+        std::vector<uint8_t> kinds(opCount);
+        for (auto& kind : kinds) {
+          unsigned roll = rng() % 100;
+          kind = roll < mix.lookups ? 0 : roll < mix.lookups + mix.inserts ? 1 : 2;
+        }
+        workloads.push_back({pattern, mix.name, keys, std::move(kinds)});
+      }
+    }
+
+    struct Contender {
+      std::string method;
+      size_t nodeBytes;
+      std::vector<Result> (*run)(const std::vector<int>&, const std::vector<Workload>&, double&, uint64_t&);
+    };
+    const std::vector<Contender> contenders = {
+        {"AVLTree", sizeof(AVLNode), runTree<AVLTree>},
+        {"BSTTree", sizeof(BSTNode), runTree<BSTTree>},
+        {"SplayTree", sizeof(SplayNode), runTree<SplayTree>},
+        {"Treap", sizeof(TreapNode), runTree<Treap>},
+    };
+
+    std::vector<Result> reference;
+    uint64_t referenceFinal = 0;
+    for (const Contender& contender : contenders) {
+      double buildNs = 0;
+      uint64_t finalChecksum = 0;
+      std::vector<Result> results = contender.run(initialKeys, workloads, buildNs, finalChecksum);
+      if (reference.empty()) {
+        reference = results;
+        referenceFinal = finalChecksum;
+      }
+
+      for (size_t i = 0; i < workloads.size(); i++) {
+        const Result& result = results[i];
+        bool valid = result.checksum == reference[i].checksum && finalChecksum == referenceFinal;
+        allValid = allValid && valid;
+        std::cout << size << " / " << contender.method << " / " << workloads[i].pattern << " / " << workloads[i].mix
+                  << ": " << result.nsPerOp << " ns/op, height " << result.height << ", "
+                  << result.reservedPerKey << " B/key reserved" << (valid ? "" : " INVALID RESULT") << std::endl;
+        csv << contender.method << ',' << size << ',' << workloads[i].pattern << ',' << workloads[i].mix << ','
+            << opCount << ',' << buildNs << ',' << result.nsPerOp << ',' << result.height << ','
+            << contender.nodeBytes << ',' << result.reservedPerKey << ',' << (valid ? "true" : "false") << '\n';
+      }
+    }
+  }
+
+  std::cout << "Results saved to " << csvPath << std::endl;
+  return allValid ? 0 : 1;
+}